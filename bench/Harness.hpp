@@ -0,0 +1,170 @@
+#ifndef _HARNESS_HPP_
+# define _HARNESS_HPP_
+
+# include "ServerKqueue.hpp"
+# include <string>
+# include <vector>
+# include <stdexcept>
+# include <cstring>
+# include <cerrno>
+# include <fcntl.h>
+# include <time.h>
+# include <sys/resource.h>
+# include <sys/socket.h>
+
+/*
+	네트워크 없이 서버 로직을 돌려보는 시험 도구(벤치마크용)
+
+	1. 리슨 소켓 없이 Server를 만든다. 호스트 이름은 찾지 않고 넘겨준 값을 쓴다
+	2. 가짜 클라이언트는 socketpair로 붙인다. 한쪽은 reactor에 붙이고(attachClient), 다른 쪽(peer)으로 명령을 보내고 응답을 읽는다
+		a. 클라이언트 주소(in_addr)도 넘겨줄 수 있다. 접속 등급(흐름 제어, 송신 큐 한도)이 이 주소로 정해진다
+		b. 서버는 기본으로 loopback도 흐름 제어를 한다. 명령어 비용만 재려고 Harness가 loopback을 trusted 등급으로 둔다(ConnClass::trust)
+	3. reactor는 이 스레드에서 한 바퀴씩(runOnce) 돌린다. 기다리지 않는다
+	4. dispatch()는 줄 하나를 파싱해서 Server::runCommand만 부른다. 이것만 재면 recv, send 없이 명령어 비용만 나온다
+		a. 쌓인 응답은 다음 step()에서 보낸다
+	5. 시간은 이 스레드의 CPU 시간(CLOCK_THREAD_CPUTIME_ID, ns)으로 잰다
+*/
+
+class Harness {
+private:
+	Server server;
+	Reactor* reactor;
+
+	// 클라이언트 번호 -> peer fd, 서버 쪽 Client의 핸들(fd는 끊긴 뒤 재사용될 수 있다)
+	std::vector<int> peers;
+	std::vector<ClientHandle> handles;
+
+	Message message;
+	std::string line;
+
+	// 사용 안 함
+	Harness(Harness const& ref);
+	Harness& operator=(Harness const& ref);
+public:
+	explicit Harness(std::string const& host = "irc.test", std::string const& password = "pw") : server("6667", password, 1, host), reactor(NULL) {
+		ConnClass::trust("127.0.0.0/8");
+		this->server.init(false);
+		this->reactor = this->server.getReactor(0);
+		this->reactor->enter();
+	}
+
+	~Harness() {
+		for (size_t i = 0; i < this->peers.size(); i++)
+			close(this->peers[i]);
+	}
+
+	// 클라이언트 수만큼 fd를 쓸 수 있게 소프트 상한을 올린다. Harness를 만들기 전에 부른다(ClientTable 크기가 이걸로 정해진다)
+	static void raiseFdLimit() {
+		struct rlimit limit;
+
+		if (getrlimit(RLIMIT_NOFILE, &limit) == SYS_FAILURE)
+			return ;
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	static unsigned long cpuNow() {
+		struct timespec ts;
+
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+		return static_cast<unsigned long>(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+	}
+
+	// 가짜 클라이언트를 붙이고 번호를 돌려준다. 기본 주소는 loopback(Harness에서는 trusted 등급)
+	int connect(in_addr info) {
+		int pair[2];
+		Client* client;
+
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == SYS_FAILURE)
+			throw std::runtime_error("Error : socketpair");
+		fcntl(pair[1], F_SETFL, O_NONBLOCK);
+		if ((client = this->reactor->attachClient(pair[0], info)) == NULL) {
+			close(pair[1]);
+			throw std::runtime_error("Error : no client slot");
+		}
+		this->peers.push_back(pair[1]);
+		this->handles.push_back(client->getHandle());
+		return this->peers.size() - 1;
+	}
+
+	int connect() {
+		in_addr info;
+
+		info.s_addr = htonl(INADDR_LOOPBACK);
+		return connect(info);
+	}
+
+	// 붙이고 PASS, NICK, USER까지 마친다. 환영 묶음은 읽어서 버린다
+	int registerClient(std::string const& nick) {
+		int id = connect();
+
+		send(id, "PASS " + this->server.getPassword());
+		send(id, "NICK " + nick);
+		send(id, "USER " + nick + " h s :" + nick);
+		step();
+		receive(id);
+		return id;
+	}
+
+	// CRLF를 붙여 peer로 보낸다. 처리는 step()에서 한다
+	void send(int id, std::string const& text) {
+		std::string data = text + CRLF;
+
+		if (::send(this->peers[id], data.data(), data.size(), 0) != static_cast<ssize_t>(data.size()))
+			throw std::runtime_error("Error : harness send");
+	}
+
+	// reactor 한 바퀴(recv, 명령어 실행, 응답 전송)
+	void step() {
+		this->reactor->runOnce(false);
+	}
+
+	// 서버를 거치지 않고 명령어 실행만. 수신 버퍼와 reactor 대기열은 건드리지 않는다
+	void dispatch(int id, std::string const& text) {
+		Client* client = getClient(id);
+
+		this->line = text;
+		if (client == NULL || !this->message.parse(StrView(this->line.data(), this->line.size())))
+			return ;
+		ScopedLock lock(this->server.getStateLock());
+		this->server.runCommand(*client, this->message);
+	}
+
+	// peer에 도착한 내용을 전부 읽는다
+	std::string receive(int id) {
+		std::string out;
+		char buf[65536];
+		ssize_t n;
+
+		while ((n = recv(this->peers[id], buf, sizeof(buf), 0)) > 0)
+			out.append(buf, n);
+		return out;
+	}
+
+	// 모든 peer를 비운다. 비우지 않으면 방송이 송신 큐에 쌓인다. 읽은 바이트 수
+	size_t drainAll() {
+		char buf[65536];
+		size_t total = 0;
+		ssize_t n;
+
+		for (size_t i = 0; i < this->peers.size(); i++)
+			while ((n = recv(this->peers[i], buf, sizeof(buf), 0)) > 0)
+				total += n;
+		return total;
+	}
+
+	// 연결이 남아 있으면 서버 쪽 Client, 끊겼으면 NULL
+	Client* getClient(int id) {
+		return this->server.getClients().find(this->handles[id]);
+	}
+
+	size_t size() const {
+		return this->peers.size();
+	}
+
+	Server& getServer() {
+		return this->server;
+	}
+};
+
+#endif
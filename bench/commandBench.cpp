@@ -0,0 +1,169 @@
+#include "Harness.hpp"
+#include "Logger.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <cstdlib>
+
+/**
+ * 네트워크 없이(socketpair) 명령어 하나의 CPU 비용을 잰다. bench/Harness.hpp 사용.
+ * 사용법 : ./bench/commandBench [repeat]
+ *          ./bench/commandBench -f <script> [repeat]
+ * dispatch : Server::runCommand만(파싱, 명령어 실행, 송신 큐에 넣기)
+ * flush    : 이어지는 reactor 한 바퀴(가입자마다 writev)
+ * 기본 시나리오는 채널 가입자 수(1 ~ 1000)를 바꿔가며 JOIN, MODE, PRIVMSG 비용을 잰다.
+ * 스크립트는 한 줄에 "<클라이언트 번호> <IRC 명령>"이고, #으로 시작하면 주석이다.
+ * 처음 나온 번호의 클라이언트는 c<번호>라는 별칭으로 등록해 둔다. 스크립트 전체를 repeat번 돌린다.
+ */
+
+# define CNT_REPEAT 2000 // 명령어마다 재는 횟수
+
+struct Samples {
+	std::vector<unsigned long> dispatch;
+	std::vector<unsigned long> flush;
+};
+
+static unsigned long percentile(std::vector<unsigned long> values, double p) {
+	if (values.empty())
+		return 0;
+	std::sort(values.begin(), values.end());
+	return values[static_cast<size_t>((values.size() - 1) * p)];
+}
+
+static double mean(std::vector<unsigned long> const& values) {
+	double sum = 0;
+
+	for (size_t i = 0; i < values.size(); i++)
+		sum += values[i];
+	return values.empty() ? 0 : sum / values.size();
+}
+
+static void header() {
+	std::cout << std::right << std::setw(8) << "members" << "  " << std::left << std::setw(10) << "command"
+		<< std::right << std::setw(14) << "dispatch avg" << std::setw(10) << "p50" << std::setw(10) << "p99"
+		<< std::setw(14) << "flush avg" << "  (ns, thread CPU)" << std::endl;
+}
+
+static void report(std::string const& members, std::string const& command, Samples const& samples) {
+	std::cout << std::right << std::setw(8) << members << "  " << std::left << std::setw(10) << command
+		<< std::right << std::fixed << std::setprecision(0)
+		<< std::setw(14) << mean(samples.dispatch) << std::setw(10) << percentile(samples.dispatch, 0.5)
+		<< std::setw(10) << percentile(samples.dispatch, 0.99) << std::setw(14) << mean(samples.flush) << std::endl;
+}
+
+// 명령어 실행과 이어지는 한 바퀴를 따로 잰다. peer는 재지 않고 비운다
+static void measure(Harness& harness, int id, std::string const& line, Samples& samples) {
+	unsigned long start = Harness::cpuNow();
+
+	harness.dispatch(id, line);
+	unsigned long mid = Harness::cpuNow();
+	harness.step();
+	unsigned long end = Harness::cpuNow();
+
+	samples.dispatch.push_back(mid - start);
+	samples.flush.push_back(end - mid);
+	harness.drainAll();
+}
+
+static std::string nickOf(size_t id) {
+	std::ostringstream oss;
+
+	oss << "c" << id;
+	return oss.str();
+}
+
+/**
+ * 가입자 수마다 채널 하나(#s<크기>)를 채우면서 JOIN을 재고, 다 채운 채널에서 MODE, PRIVMSG를 잰다.
+ * 0번 클라이언트가 모든 채널을 처음 만들어 채널 관리자가 된다.
+ */
+static void runScenarios(int repeat) {
+	size_t const sizes[] = {1, 10, 100, 1000};
+	Harness harness;
+	Samples ping;
+
+	for (size_t i = 0; i < sizes[3]; i++)
+		harness.registerClient(nickOf(i));
+	header();
+	for (int r = 0; r < repeat; r++)
+		measure(harness, 0, "PING irc.test", ping);
+	report("-", "PING", ping);
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		std::ostringstream name;
+		std::ostringstream members;
+		Samples join;
+		Samples mode;
+		Samples privmsg;
+
+		name << "#s" << sizes[s];
+		members << sizes[s];
+		for (size_t i = 0; i < sizes[s]; i++)
+			measure(harness, i, "JOIN " + name.str(), join);
+		for (int r = 0; r < repeat; r++) {
+			measure(harness, 0, "MODE " + name.str() + (r % 2 ? " -t" : " +t"), mode);
+			measure(harness, 0, "PRIVMSG " + name.str() + " :hello, this is a benchmark line", privmsg);
+		}
+		report(members.str(), "JOIN", join);
+		report(members.str(), "MODE", mode);
+		report(members.str(), "PRIVMSG", privmsg);
+	}
+}
+
+static void runScript(char const* path, int repeat) {
+	std::ifstream file(path);
+	std::vector<std::pair<size_t, std::string> > script;
+	std::map<std::string, Samples> byCommand;
+	std::string text;
+	Harness harness;
+
+	if (!file)
+		throw std::runtime_error(std::string("Error : cannot open ") + path);
+	while (std::getline(file, text)) {
+		std::istringstream iss(text);
+		size_t id;
+		std::string line;
+
+		if (text.empty() || text[0] == '#' || !(iss >> id))
+			continue ;
+		std::getline(iss >> std::ws, line);
+		script.push_back(std::make_pair(id, line));
+		while (harness.size() <= id)
+			harness.registerClient(nickOf(harness.size()));
+	}
+	for (int r = 0; r < repeat; r++) {
+		for (size_t i = 0; i < script.size(); i++) {
+			std::string command = script[i].second.substr(0, script[i].second.find(' '));
+
+			std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+			measure(harness, script[i].first, script[i].second, byCommand[command]);
+		}
+	}
+	header();
+	for (std::map<std::string, Samples>::iterator it = byCommand.begin(); it != byCommand.end(); it++)
+		report("-", it->first, it->second);
+}
+
+int main(int ac, char* av[]) {
+	bool scripted = ac > 2 && std::string(av[1]) == "-f";
+	int repeat = CNT_REPEAT;
+	int devNull = open("/dev/null", O_WRONLY);
+
+	if (ac > (scripted ? 3 : 1))
+		repeat = std::atoi(av[scripted ? 3 : 1]);
+	// 접속, 종료 로그(INFO)는 버퍼에 넣지도 않고, 경고 이상은 /dev/null로 보낸다
+	Logger::start(devNull, LOG_WARN);
+	Harness::raiseFdLimit();
+	try {
+		if (scripted)
+			runScript(av[2], repeat);
+		else
+			runScenarios(repeat);
+	} catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+	}
+	Logger::stop();
+	return 0;
+}
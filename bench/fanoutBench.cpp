@@ -0,0 +1,139 @@
+#include "Client.hpp"
+#include "ClientTable.hpp"
+#include "Channel.hpp"
+#include "utils.hpp"
+#include "Buffer.hpp"
+#include "Message.hpp"
+#include "NickIndex.hpp"
+#include "CommandExecute.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+/**
+ * 채널 하나에 PRIVMSG 한 줄을 뿌리는 비용을 가입자 수(10 ~ 10,000)를 바꿔가며 잰다.
+ * 사용법 : ./bench/fanoutBench [deliveries per size]
+ * walk    : 가입자를 훑기만 하는 비용. 예전의 map(userList)과 새 배열(members)을 비교한다
+ * privmsg : CommandExecute::privmsg 전체와 루프 끝의 flushPending. 가입자마다 writev까지 한다
+ * 가입자 소켓은 루프백 UDP 싱크 하나에 연결해 두므로 fd를 가입자당 하나만 쓴다.
+ */
+
+# define CNT_DELIVERY 200000 // 크기마다 전달할 총 메세지 수
+
+static double now() {
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+}
+
+static void report(size_t members, char const* phase, double elapsed, long deliveries) {
+	std::cout << std::right << std::setw(6) << members << " members  " << std::left << std::setw(12) << phase
+		<< std::right << std::fixed << std::setprecision(1) << std::setw(10) << elapsed / deliveries << " ns/recipient" << std::endl;
+}
+
+static int openSink(struct sockaddr_in& addr) {
+	socklen_t len = sizeof(addr);
+	int fd = socket(PF_INET, SOCK_DGRAM, 0);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == SYS_FAILURE
+		|| getsockname(fd, (struct sockaddr*)&addr, &len) == SYS_FAILURE)
+		throw std::runtime_error("Error : sink");
+	return fd;
+}
+
+static void benchSize(size_t size, long deliveries, struct sockaddr_in const& sinkAddr) {
+	Buffer buffer;
+	ClientTable table;
+	NickIndex nickIndex;
+	chlmap chlList;
+	std::vector<Client*> clients;
+	Channel* channel;
+	Message message;
+	std::vector<int> failed;
+	std::vector<int> blocked;
+	std::vector<int> overflowed;
+	char const* line = "PRIVMSG #bench :the quick brown fox jumps over the lazy dog";
+	long rounds = deliveries / size > 0 ? deliveries / size : 1;
+	volatile long sink = 0; // 훑는 루프가 최적화로 지워지지 않게 결과를 모은다
+	double start;
+
+	Buffer::bind(&buffer);
+	for (size_t i = 0; i < size; i++) {
+		int fd = socket(PF_INET, SOCK_DGRAM, 0);
+		std::ostringstream nick;
+
+		if (fd == SYS_FAILURE || connect(fd, (struct sockaddr const*)&sinkAddr, sizeof(sinkAddr)) == SYS_FAILURE)
+			throw std::runtime_error("Error : socket (raise ulimit -n)");
+		fcntl(fd, F_SETFL, O_NONBLOCK);
+		clients.push_back(table.create(fd, sinkAddr.sin_addr, 0));
+		clients.back()->setNickIndex(&nickIndex);
+		nick << "u" << i;
+		clients.back()->setNick(nick.str());
+		clients.back()->setUser("bench");
+		Buffer::resetSendBuf(fd, 0);
+	}
+	channel = new Channel("#bench", clients[0]);
+	chlList.insert(std::make_pair(std::string("#bench"), channel));
+	for (size_t i = 0; i < size; i++)
+		channel->addClientList(clients[i]);
+	message.parse(StrView(line, strlen(line)));
+
+	start = now();
+	for (long r = 0; r < rounds; r++)
+		for (hdlmap::const_iterator it = channel->getUserList().begin(); it != channel->getUserList().end(); it++)
+			sink += it->second->getClientFd();
+	report(size, "walk map", now() - start, rounds * size);
+
+	start = now();
+	for (long r = 0; r < rounds; r++) {
+		cltvec const& members = channel->getMembers();
+		for (size_t i = 0; i < members.size(); i++)
+			sink += members[i]->getClientFd();
+	}
+	report(size, "walk vector", now() - start, rounds * size);
+
+	// 서버 루프처럼 명령어 하나를 처리하고 나서 쌓인 응답을 보낸다
+	start = now();
+	for (long r = 0; r < rounds; r++) {
+		CommandExecute::privmsg(message, *clients[0], chlList, nickIndex, "bench");
+		Buffer::flushPending(failed, blocked, overflowed);
+	}
+	report(size, "privmsg", now() - start, rounds * (size - 1 > 0 ? size - 1 : 1));
+
+	delete channel;
+	for (size_t i = 0; i < clients.size(); i++)
+		table.destroy(clients[i]->getClientFd());
+}
+
+int main(int ac, char* av[]) {
+	static size_t const sizes[] = { 10, 100, 1000, 10000 };
+	long deliveries = ac > 1 ? std::atol(av[1]) : CNT_DELIVERY;
+	struct rlimit limit;
+	struct sockaddr_in addr;
+	int sink;
+
+	// 가입자 10,000명을 만들 수 있게 fd 상한을 올린다
+	getrlimit(RLIMIT_NOFILE, &limit);
+	limit.rlim_cur = limit.rlim_max;
+	setrlimit(RLIMIT_NOFILE, &limit);
+
+	sink = openSink(addr);
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+		benchSize(sizes[i], deliveries, addr);
+	close(sink);
+	return 0;
+}
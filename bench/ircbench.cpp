@@ -0,0 +1,523 @@
+#include "Poller.hpp"
+#include "utils.hpp"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+/**
+ * ircserv 종단 간 부하 생성기
+ * 1. 스레드마다 클라이언트 여러 개를 논블로킹으로 연결해서 PASS, NICK, USER로 등록한다
+ * 2. 클라이언트마다 채널을 몇 개 고른다. 채널 크기는 zipf 분포를 따른다(-s 0이면 고르게)
+ * 3. 전부 등록하고 채널에 들어간 뒤부터, 클라이언트마다 초당 rate개씩 자기 채널에 PRIVMSG를 보낸다
+ *	a. 메세지에는 보낸 시각(CLOCK_MONOTONIC, ns)을 담고, 받는 쪽이 그 차이로 전달 지연을 잰다
+ *	b. 같은 기계의 loopback이라 송신, 수신 시계가 같다
+ * 4. 초당 연결 수, 초당 보낸 메세지 수, 초당 전달된 메세지 수, 지연의 p50, p99, p999를 출력한다
+ *
+ * 사용법 : ./ircbench <port> <password> [-c clients] [-t threads] [-d seconds] [-r msgs/sec per client]
+ *                     [-C channels] [-j joins per client] [-s zipf exponent] [-m message bytes] [-a address]
+ * ircserv는 기본으로 loopback도 흐름 제어를 한다. 제한 없이 몰아붙이려면 ircserv를 -x 127.0.0.0/8로 띄운다.
+ * 연결하지 못한 클라이언트는 세어서 보고하고, 나머지 클라이언트로 계속한다.
+ */
+
+// 지연 히스토그램. 2의 거듭제곱 구간마다 16칸(오차 약 6%), us 단위
+# define HIST_SUB_BITS 4
+# define HIST_SUB (1 << HIST_SUB_BITS)
+# define HIST_BUCKETS (64 * HIST_SUB)
+
+struct Histogram {
+	unsigned long counts[HIST_BUCKETS];
+	unsigned long total;
+	unsigned long max;
+
+	Histogram() : total(0), max(0) {
+		memset(counts, 0, sizeof(counts));
+	}
+
+	static size_t index(unsigned long value) {
+		int exp = 0;
+
+		if (value < HIST_SUB)
+			return value;
+		while ((value >> exp) >= (HIST_SUB << 1))
+			exp++;
+		return (exp + 1) * HIST_SUB + ((value >> exp) - HIST_SUB);
+	}
+
+	// 칸의 윗 경계
+	static unsigned long upper(size_t index) {
+		if (index < HIST_SUB)
+			return index;
+		int exp = index / HIST_SUB - 1;
+		return (((index % HIST_SUB) + HIST_SUB + 1) << exp) - 1;
+	}
+
+	void record(unsigned long value) {
+		counts[index(value)]++;
+		total++;
+		if (value > max)
+			max = value;
+	}
+
+	void merge(Histogram const& other) {
+		for (size_t i = 0; i < HIST_BUCKETS; i++)
+			counts[i] += other.counts[i];
+		total += other.total;
+		if (other.max > max)
+			max = other.max;
+	}
+
+	unsigned long percentile(double p) const {
+		unsigned long rank = static_cast<unsigned long>(std::ceil(total * p));
+		unsigned long seen = 0;
+
+		for (size_t i = 0; i < HIST_BUCKETS; i++) {
+			seen += counts[i];
+			if (seen >= rank && seen > 0)
+				return upper(i) < max ? upper(i) : max;
+		}
+		return max;
+	}
+};
+
+struct Options {
+	int port;
+	std::string password;
+	std::string address;
+	int clients;
+	int threads;
+	int seconds;
+	double rate;
+	int channels;
+	int joins;
+	double zipf;
+	int messageSize;
+};
+
+enum ConnState {
+	CONNECTING,
+	REGISTERING,
+	READY,
+	FAILED
+};
+
+struct Conn {
+	int fd;
+	int id;
+	std::string nick;
+	ConnState state;
+	bool writeArmed;
+	int joinsLeft;
+	std::string channel;
+	std::string in;
+	std::string out;
+	unsigned long nextSend;
+};
+
+struct Worker {
+	pthread_t thread;
+	int first;
+	int count;
+	Options const* options;
+	std::vector<double> const* weights;
+	Histogram latency;
+	unsigned long sent;
+	unsigned long delivered;
+	unsigned long errors;
+	unsigned long failed;
+	int failError;
+};
+
+static volatile int readyCount = 0;
+static volatile int failedCount = 0;
+static volatile int joinedCount = 0;
+static volatile bool sending = false;
+static volatile bool measuring = false;
+static volatile bool finished = false;
+
+static std::string toString(int value) {
+	std::ostringstream oss;
+
+	oss << value;
+	return oss.str();
+}
+
+static unsigned long nowNs() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<unsigned long>(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+}
+
+// 채널 번호를 zipf 분포(누적 가중치)로 고른다
+static int pickChannel(std::vector<double> const& weights, unsigned int* seed) {
+	double r = static_cast<double>(rand_r(seed)) / RAND_MAX * weights.back();
+
+	return std::lower_bound(weights.begin(), weights.end(), r) - weights.begin();
+}
+
+static void flushOut(Poller* poller, Conn& conn) {
+	while (!conn.out.empty()) {
+		ssize_t n = send(conn.fd, conn.out.data(), conn.out.size(), 0);
+
+		if (n <= 0)
+			break ;
+		conn.out.erase(0, n);
+	}
+	if (conn.out.empty() == conn.writeArmed) {
+		conn.writeArmed = !conn.out.empty();
+		poller->modify(conn.fd, POLLER_READ | (conn.writeArmed ? POLLER_WRITE : 0));
+	}
+}
+
+// 실패하면 errno를 남기고 SYS_FAILURE. 작업 스레드에서 부르므로 예외를 던지지 않는다
+static int connectTo(Options const& options) {
+	struct sockaddr_in addr;
+	int fd = socket(PF_INET, SOCK_STREAM, 0);
+	int error;
+
+	if (fd == SYS_FAILURE)
+		return SYS_FAILURE;
+	fcntl(fd, F_SETFL, O_NONBLOCK);
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = inet_addr(options.address.c_str());
+	addr.sin_port = htons(options.port);
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == SYS_FAILURE && errno != EINPROGRESS) {
+		error = errno;
+		close(fd);
+		errno = error;
+		return SYS_FAILURE;
+	}
+	return fd;
+}
+
+// 논블로킹 connect가 실패했으면 그 errno, 아직 진행 중이거나 맺어졌으면 0
+static int connectError(int fd) {
+	int error = 0;
+	socklen_t size = sizeof(error);
+
+	if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) == SYS_FAILURE)
+		return errno;
+	return error;
+}
+
+// 연결하지 못한 클라이언트. 세어두고 등록, 입장을 기다리는 수에서 뺀다
+static void failConnection(Worker& w, Poller* poller, Conn& conn, int error) {
+	if (conn.fd != SYS_FAILURE) {
+		poller->remove(conn.fd);
+		close(conn.fd);
+		conn.fd = SYS_FAILURE;
+	}
+	conn.state = FAILED;
+	w.failed++;
+	w.failError = error;
+	__sync_add_and_fetch(&failedCount, 1);
+}
+
+// 서버가 보낸 줄 하나
+static void handleLine(Worker& w, Conn& conn, std::string const& line) {
+	size_t pos;
+
+	if (conn.state == REGISTERING && line.find(" 001 ") != std::string::npos) {
+		conn.state = READY;
+		__sync_add_and_fetch(&readyCount, 1);
+		return ;
+	}
+	// 내 JOIN이 돌아왔는지(다른 클라이언트의 JOIN도 같은 모양으로 온다)
+	if (conn.joinsLeft > 0 && line.find(" JOIN ") != std::string::npos && line.compare(0, conn.nick.size() + 2, ":" + conn.nick + "!") == 0) {
+		if (--conn.joinsLeft == 0)
+			__sync_add_and_fetch(&joinedCount, 1);
+		return ;
+	}
+	if ((pos = line.find(" PRIVMSG #")) != std::string::npos) {
+		if ((pos = line.find(" :", pos)) == std::string::npos)
+			return ;
+		unsigned long stamp = std::strtoul(line.c_str() + pos + 2, NULL, 10);
+		unsigned long now = nowNs();
+
+		if (measuring && stamp > 0 && now >= stamp) {
+			w.latency.record((now - stamp) / 1000);
+			w.delivered++;
+		}
+		return ;
+	}
+	// ERROR, 4xx 응답은 센다
+	if (line.compare(0, 5, "ERROR") == 0 || ((pos = line.find(' ')) != std::string::npos && line.compare(pos, 2, " 4") == 0))
+		w.errors++;
+}
+
+static void* workerMain(void* arg) {
+	Worker* w = static_cast<Worker*>(arg);
+	Options const& options = *w->options;
+	Poller* poller = Poller::create();
+	std::vector<Conn> conns(w->count);
+	std::vector<int> byFd;
+	PollEvent events[MAX_EVENTS_PER_WAKEUP];
+	unsigned int seed = w->first * 7919 + 1;
+	unsigned long interval = options.rate > 0 ? static_cast<unsigned long>(1e9 / options.rate) : 0;
+	std::string padding(options.messageSize, 'x');
+	bool started = false;
+
+	for (int i = 0; i < w->count; i++) {
+		Conn& conn = conns[i];
+
+		conn.id = w->first + i;
+		conn.nick = "b" + toString(conn.id);
+		conn.state = CONNECTING;
+		conn.writeArmed = true;
+		conn.joinsLeft = 0;
+		if ((conn.fd = connectTo(options)) == SYS_FAILURE) {
+			failConnection(*w, poller, conn, errno);
+			continue ;
+		}
+		if (static_cast<size_t>(conn.fd) >= byFd.size())
+			byFd.resize(conn.fd + 1, -1);
+		byFd[conn.fd] = i;
+		poller->add(conn.fd, POLLER_READ | POLLER_WRITE);
+	}
+
+	while (!finished) {
+		int cnt = poller->wait(events, MAX_EVENTS_PER_WAKEUP, 1);
+
+		for (int i = 0; i < cnt; i++) {
+			Conn& conn = conns[byFd[events[i].fd]];
+			char buf[16384];
+			ssize_t n;
+			size_t pos;
+			int error;
+
+			if (conn.state == CONNECTING && (error = connectError(conn.fd)) != 0) {
+				failConnection(*w, poller, conn, error);
+				continue ;
+			}
+			// 연결이 맺어졌으면 등록을 보낸다
+			if (conn.state == CONNECTING && (events[i].events & POLLER_WRITE)) {
+				std::ostringstream reg;
+
+				reg << "PASS " << options.password << "\r\nNICK " << conn.nick << "\r\nUSER bench h s :bench\r\n";
+				conn.out += reg.str();
+				conn.state = REGISTERING;
+			}
+			while ((n = recv(conn.fd, buf, sizeof(buf), 0)) > 0)
+				conn.in.append(buf, n);
+			while ((pos = conn.in.find("\r\n")) != std::string::npos) {
+				handleLine(*w, conn, conn.in.substr(0, pos));
+				conn.in.erase(0, pos + 2);
+			}
+			flushOut(poller, conn);
+		}
+
+		// 모두 등록을 마쳤으면 채널에 들어간다
+		if (!started && readyCount + failedCount == options.clients) {
+			started = true;
+			for (int i = 0; i < w->count; i++) {
+				Conn& conn = conns[i];
+				std::ostringstream join;
+
+				std::vector<int> picked;
+
+				if (conn.state == FAILED)
+					continue ;
+
+				// 같은 채널을 두 번 고르면 다시 고른다. 메세지는 첫 채널에 보낸다
+				while (static_cast<int>(picked.size()) < options.joins) {
+					int channel = pickChannel(*w->weights, &seed);
+
+					if (std::find(picked.begin(), picked.end(), channel) != picked.end())
+						continue ;
+					picked.push_back(channel);
+					join << "JOIN #b" << channel << "\r\n";
+				}
+				conn.channel = "#b" + toString(picked[0]);
+				conn.joinsLeft = options.joins;
+				conn.out += join.str();
+				// 보내는 시각을 흩어서 한꺼번에 몰리지 않게 한다
+				conn.nextSend = nowNs() + (interval > 0 ? rand_r(&seed) % interval : 0);
+				flushOut(poller, conn);
+			}
+		}
+
+		if (!sending || interval == 0)
+			continue ;
+		unsigned long now = nowNs();
+		for (int i = 0; i < w->count; i++) {
+			Conn& conn = conns[i];
+			char line[64];
+
+			if (conn.state == FAILED || conn.nextSend > now)
+				continue ;
+			// 밀렸으면 따라잡지 않고 한 번만 보낸다
+			conn.nextSend = conn.nextSend + interval > now ? conn.nextSend + interval : now + interval;
+			snprintf(line, sizeof(line), "PRIVMSG %s :%lu ", conn.channel.c_str(), now);
+			conn.out += line;
+			conn.out += padding;
+			conn.out += CRLF;
+			if (measuring)
+				w->sent++;
+			flushOut(poller, conn);
+		}
+	}
+	for (int i = 0; i < w->count; i++)
+		if (conns[i].fd != SYS_FAILURE)
+			close(conns[i].fd);
+	delete poller;
+	return NULL;
+}
+
+static void usage() {
+	std::cerr << "Usage : ./ircbench <port> <password> [-c clients] [-t threads] [-d seconds] [-r msgs/sec per client]" << std::endl
+		<< "                   [-C channels] [-j joins per client] [-s zipf exponent] [-m message bytes] [-a address]" << std::endl
+		<< "ircserv flood-controls loopback by default; start it with -x 127.0.0.0/8 to measure without throttling" << std::endl;
+}
+
+static bool parseOptions(int ac, char* av[], Options& options) {
+	if (ac < 3)
+		return false;
+	options.port = std::atoi(av[1]);
+	options.password = av[2];
+	options.address = "127.0.0.1";
+	options.clients = 1000;
+	options.threads = 4;
+	options.seconds = 10;
+	options.rate = 1;
+	options.channels = 20;
+	options.joins = 1;
+	options.zipf = 1.0;
+	options.messageSize = 32;
+	for (int i = 3; i + 1 < ac; i += 2) {
+		std::string option = av[i];
+		char const* value = av[i + 1];
+
+		if (option == "-c")
+			options.clients = std::atoi(value);
+		else if (option == "-t")
+			options.threads = std::atoi(value);
+		else if (option == "-d")
+			options.seconds = std::atoi(value);
+		else if (option == "-r")
+			options.rate = std::atof(value);
+		else if (option == "-C")
+			options.channels = std::atoi(value);
+		else if (option == "-j")
+			options.joins = std::atoi(value);
+		else if (option == "-s")
+			options.zipf = std::atof(value);
+		else if (option == "-m")
+			options.messageSize = std::atoi(value);
+		else if (option == "-a")
+			options.address = value;
+		else
+			return false;
+	}
+	if ((ac - 3) % 2 != 0)
+		return false;
+	return options.clients > 0 && options.threads > 0 && options.seconds > 0
+		&& options.channels > 0 && options.joins > 0 && options.joins <= CHANNEL_LIMIT_PER_USER && options.joins <= options.channels;
+}
+
+// 클라이언트 수만큼 fd를 쓸 수 있게 소프트 상한을 올린다
+static void raiseFdLimit(int clients) {
+	struct rlimit limit;
+
+	if (getrlimit(RLIMIT_NOFILE, &limit) == SYS_FAILURE)
+		return ;
+	if (limit.rlim_cur < static_cast<rlim_t>(clients + 64)) {
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+}
+
+int main(int ac, char* av[]) {
+	Options options;
+
+	if (!parseOptions(ac, av, options)) {
+		usage();
+		return 1;
+	}
+	raiseFdLimit(options.clients);
+	if (options.threads > options.clients)
+		options.threads = options.clients;
+
+	std::vector<double> weights(options.channels);
+	std::vector<Worker> workers(options.threads);
+	Histogram latency;
+	unsigned long sent = 0;
+	unsigned long delivered = 0;
+	unsigned long errors = 0;
+	unsigned long failed = 0;
+	int failError = 0;
+
+	// 채널 k의 가중치는 1 / (k + 1)^s. 누적해서 둔다
+	for (int k = 0; k < options.channels; k++)
+		weights[k] = (k > 0 ? weights[k - 1] : 0) + 1.0 / std::pow(k + 1.0, options.zipf);
+
+	unsigned long connectStart = nowNs();
+	for (int i = 0, first = 0; i < options.threads; i++) {
+		workers[i].first = first;
+		workers[i].count = options.clients / options.threads + (i < options.clients % options.threads);
+		workers[i].options = &options;
+		workers[i].weights = &weights;
+		workers[i].sent = 0;
+		workers[i].delivered = 0;
+		workers[i].errors = 0;
+		workers[i].failed = 0;
+		workers[i].failError = 0;
+		first += workers[i].count;
+		pthread_create(&workers[i].thread, NULL, &workerMain, &workers[i]);
+	}
+
+	// 등록, 채널 입장을 기다린다(최대 30초)
+	for (int i = 0; i < 30000 && readyCount + failedCount < options.clients; i++)
+		usleep(1000);
+	double connectSec = (nowNs() - connectStart) / 1e9;
+	for (int i = 0; i < 30000 && joinedCount + failedCount < options.clients; i++)
+		usleep(1000);
+
+	// 1초 데우고 잰다. 하나도 등록하지 못했으면 잴 것이 없다
+	if (readyCount > 0) {
+		sending = true;
+		sleep(1);
+		measuring = true;
+		sleep(options.seconds);
+		measuring = false;
+	}
+	finished = true;
+	for (int i = 0; i < options.threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		latency.merge(workers[i].latency);
+		sent += workers[i].sent;
+		delivered += workers[i].delivered;
+		errors += workers[i].errors;
+		failed += workers[i].failed;
+		if (workers[i].failed > 0)
+			failError = workers[i].failError;
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "clients    " << readyCount << " registered in " << connectSec << " s : "
+		<< static_cast<long>(readyCount / connectSec) << " conn/sec (joined " << joinedCount << ")" << std::endl;
+	std::cout << "messages   sent " << sent / options.seconds << " msgs/sec, delivered "
+		<< delivered / options.seconds << " msgs/sec" << std::endl;
+	std::cout << "latency    p50 " << latency.percentile(0.50) << " us, p99 " << latency.percentile(0.99)
+		<< " us, p999 " << latency.percentile(0.999) << " us, max " << latency.max << " us" << std::endl;
+	if (errors > 0)
+		std::cout << "errors     " << errors << " error replies" << std::endl;
+	if (failed > 0)
+		std::cout << "failed     " << failed << " connections (" << strerror(failError) << ")" << std::endl;
+	return readyCount > 0 ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+#include "FlightRecorder.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <arpa/inet.h>
+
+/**
+ * ircserv 기록 파일(-T) 해독기. 살아 있는 기록 파일, 덤프 둘 다 읽는다
+ * 1. reactor마다 원형 버퍼에서 head 앞까지(최대 ringRecords개)를 꺼내 시간순으로 합친다
+ *	a. 서버가 쓰는 도중에 읽었으면 가장 오래된 칸 몇 개가 덮어써졌을 수 있다. 시각이 어긋난 곳부터는 버린다
+ * 2. 시간순 기록(timeline) : 마지막 n개(-n 0이면 전부). -r, -f로 reactor, fd를 골라 볼 수 있다
+ * 3. 합계 : 종류별 개수, 받은/보낸 바이트, 다 못 보낸 쓰기, 명령어별 실행 시간, 끊은 이유, 가장 느린 바퀴
+ *
+ * 사용법 : ./irctrace <tracefile> [-n records] [-r reactor] [-f fd] [-a]
+ * -a는 합계만 출력한다.
+ */
+
+# define DEFAULT_TIMELINE 200 // 기본으로 보여줄 마지막 기록 수
+# define SLOWEST_LOOPS 5
+
+struct Options {
+	char const* path;
+	size_t last;
+	int reactor; // -1이면 전부
+	int fd; // -1이면 전부
+	bool aggregateOnly;
+};
+
+struct Trace {
+	TraceHeader header;
+	std::vector<TraceRecord> records;
+	std::vector<std::string> commands;
+};
+
+static char const* eventName[TRACE_EVENTS] = {
+	"NONE", "ACCEPT", "READ", "COMMAND", "SEND", "CLOSE", "TIMER", "LOOP", "DUMP"
+};
+
+static char const* closeName[CLOSE_REASONS] = {
+	"quit", "eof", "socket error", "send failed", "registration timeout", "ping timeout", "sendq exceeded"
+};
+
+static char const* timerName[TIMER_KINDS] = {
+	"unthrottle", "ping", "reschedule"
+};
+
+static void usage() {
+	std::cerr << "Usage : ./irctrace <tracefile> [-n records] [-r reactor] [-f fd] [-a]" << std::endl;
+}
+
+static bool parseOptions(int ac, char* av[], Options& options) {
+	if (ac < 2)
+		return false;
+	options.path = av[1];
+	options.last = DEFAULT_TIMELINE;
+	options.reactor = -1;
+	options.fd = -1;
+	options.aggregateOnly = false;
+	for (int i = 2; i < ac; i++) {
+		std::string option = av[i];
+
+		if (option == "-a")
+			options.aggregateOnly = true;
+		else if (option == "-n" && i + 1 < ac)
+			options.last = std::strtoul(av[++i], NULL, 10);
+		else if (option == "-r" && i + 1 < ac)
+			options.reactor = std::atoi(av[++i]);
+		else if (option == "-f" && i + 1 < ac)
+			options.fd = std::atoi(av[++i]);
+		else
+			return false;
+	}
+	return true;
+}
+
+static bool byTime(TraceRecord const& lhs, TraceRecord const& rhs) {
+	return lhs.time < rhs.time;
+}
+
+/**
+ * 파일 전체를 읽어서 머리를 확인하고, reactor마다 남은 기록을 꺼낸다.
+ * 원형 버퍼 안에서 시각은 늘어나기만 한다. 최근 것부터 거꾸로 읽다가 뒤 기록보다 늦은 기록이 나오면
+ * 읽는 동안 새로 덮어쓴 칸이니 거기서 멈춘다.
+ */
+static void load(char const* path, Trace& trace) {
+	std::ifstream file(path, std::ios::binary);
+	std::vector<char> data;
+	TraceHeader const* header;
+
+	if (!file)
+		throw std::runtime_error(std::string("Error : cannot open ") + path);
+	data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	if (data.size() < TRACE_HEADER_SIZE)
+		throw std::runtime_error("Error : trace file is too short");
+	header = reinterpret_cast<TraceHeader const*>(&data[0]);
+	if (memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic)) != 0 || header->version != TRACE_VERSION)
+		throw std::runtime_error("Error : not an ircserv trace file");
+	if (data.size() < TRACE_HEADER_SIZE + header->reactorCount * TRACE_RING_SIZE(header->ringRecords)
+		|| header->commandCount > TRACE_MAX_COMMANDS)
+		throw std::runtime_error("Error : trace file is truncated");
+	trace.header = *header;
+	for (size_t i = 0; i < header->commandCount; i++)
+		trace.commands.push_back(std::string(header->commands[i], strnlen(header->commands[i], TRACE_NAME_LEN)));
+
+	for (uint32_t r = 0; r < header->reactorCount; r++) {
+		char const* ring = &data[0] + TRACE_HEADER_SIZE + r * TRACE_RING_SIZE(header->ringRecords);
+		uint64_t head = reinterpret_cast<TraceRingHeader const*>(ring)->head;
+		TraceRecord const* records = reinterpret_cast<TraceRecord const*>(ring + sizeof(TraceRingHeader));
+		uint64_t count = head < header->ringRecords ? head : header->ringRecords;
+		uint64_t later = ~0ULL;
+
+		for (uint64_t pos = head; pos > head - count; pos--) {
+			TraceRecord const& record = records[(pos - 1) % header->ringRecords];
+
+			if (record.time > later || record.time < header->monoStart)
+				break ;
+			later = record.time;
+			if (record.type != TRACE_NONE && record.type < TRACE_EVENTS)
+				trace.records.push_back(record);
+		}
+	}
+	std::stable_sort(trace.records.begin(), trace.records.end(), byTime);
+}
+
+static std::string commandName(Trace const& trace, uint16_t index) {
+	return index < trace.commands.size() ? trace.commands[index] : "(unknown)";
+}
+
+// 벽시계 시각(초 이하 us까지)
+static std::string wallTime(Trace const& trace, uint64_t time) {
+	uint64_t wall = trace.header.wallStart + (time - trace.header.monoStart);
+	time_t sec = wall / 1000000000ULL;
+	char stamp[32];
+	char out[48];
+
+	strftime(stamp, sizeof(stamp), "%H:%M:%S", localtime(&sec));
+	snprintf(out, sizeof(out), "%s.%06lu", stamp, static_cast<unsigned long>(wall % 1000000000ULL / 1000));
+	return out;
+}
+
+static std::string describe(Trace const& trace, TraceRecord const& record) {
+	std::ostringstream oss;
+	in_addr addr;
+
+	oss << std::fixed << std::setprecision(1);
+	switch (record.type) {
+	case TRACE_ACCEPT:
+		addr.s_addr = record.value;
+		oss << inet_ntoa(addr);
+		break ;
+	case TRACE_READ:
+		if (record.value == TRACE_FAILED)
+			oss << "failed";
+		else
+			oss << record.value << " bytes" << (record.value == 0 ? " (eof)" : "");
+		break ;
+	case TRACE_COMMAND:
+		oss << commandName(trace, record.extra) << " " << record.value / 1000.0 << "us " << record.aux << "B";
+		break ;
+	case TRACE_SEND:
+		if (record.value == TRACE_FAILED)
+			oss << "failed";
+		else
+			oss << record.value << " bytes" << (record.aux > 0 ? " (partial, " : "");
+		if (record.value != TRACE_FAILED && record.aux > 0)
+			oss << record.aux << " left)";
+		break ;
+	case TRACE_CLOSE:
+		oss << (record.extra < CLOSE_REASONS ? closeName[record.extra] : "?");
+		break ;
+	case TRACE_TIMER:
+		oss << (record.extra < TIMER_KINDS ? timerName[record.extra] : "?");
+		break ;
+	case TRACE_LOOP:
+		oss << record.value / 1000.0 << "us " << record.aux << " events";
+		break ;
+	case TRACE_DUMP:
+		oss << (record.extra ? "slow loop" : "signal");
+		break ;
+	}
+	return oss.str();
+}
+
+static bool selected(Options const& options, TraceRecord const& record) {
+	return (options.reactor < 0 || record.reactor == options.reactor)
+		&& (options.fd < 0 || record.fd == options.fd);
+}
+
+static void printTimeline(Options const& options, Trace const& trace) {
+	std::vector<TraceRecord const*> shown;
+	size_t first = 0;
+
+	for (size_t i = 0; i < trace.records.size(); i++) {
+		if (selected(options, trace.records[i]))
+			shown.push_back(&trace.records[i]);
+	}
+	if (options.last != 0 && shown.size() > options.last)
+		first = shown.size() - options.last;
+	for (size_t i = first; i < shown.size(); i++) {
+		TraceRecord const& record = *shown[i];
+
+		std::cout << wallTime(trace, record.time) << " r" << static_cast<int>(record.reactor) << " ";
+		if (record.fd >= 0)
+			std::cout << "fd " << std::setw(5) << std::left << record.fd;
+		else
+			std::cout << std::setw(8) << std::left << "-";
+		std::cout << std::setw(8) << eventName[record.type] << std::right << " " << describe(trace, record) << std::endl;
+	}
+}
+
+static unsigned long percentile(std::vector<unsigned long>& values, double p) {
+	if (values.empty())
+		return 0;
+	std::sort(values.begin(), values.end());
+	return values[static_cast<size_t>((values.size() - 1) * p)];
+}
+
+static bool slower(TraceRecord const* lhs, TraceRecord const* rhs) {
+	return lhs->value > rhs->value;
+}
+
+/**
+ * 고른 기록만 센다. 명령어 실행 시간은 명령어 이름별로 모아서 평균, p50, p99, 최대를 낸다.
+ */
+static void printAggregate(Options const& options, Trace const& trace) {
+	unsigned long counts[TRACE_EVENTS] = {0};
+	unsigned long closes[CLOSE_REASONS] = {0};
+	unsigned long bytesIn = 0;
+	unsigned long bytesOut = 0;
+	unsigned long partial = 0;
+	unsigned long sendFailed = 0;
+	unsigned long busy = 0;
+	std::map<std::string, std::vector<unsigned long> > commands;
+	std::vector<TraceRecord const*> loops;
+	uint64_t begin = 0;
+	uint64_t end = 0;
+
+	for (size_t i = 0; i < trace.records.size(); i++) {
+		TraceRecord const& record = trace.records[i];
+
+		if (!selected(options, record))
+			continue ;
+		if (begin == 0)
+			begin = record.time;
+		end = record.time;
+		counts[record.type]++;
+		if (record.type == TRACE_READ && record.value != TRACE_FAILED)
+			bytesIn += record.value;
+		else if (record.type == TRACE_SEND && record.value == TRACE_FAILED)
+			sendFailed++;
+		else if (record.type == TRACE_SEND) {
+			bytesOut += record.value;
+			partial += record.aux > 0;
+		} else if (record.type == TRACE_COMMAND)
+			commands[commandName(trace, record.extra)].push_back(record.value);
+		else if (record.type == TRACE_CLOSE && record.extra < CLOSE_REASONS)
+			closes[record.extra]++;
+		else if (record.type == TRACE_LOOP) {
+			busy += record.value;
+			loops.push_back(&record);
+		}
+	}
+	if (begin == 0) {
+		std::cout << "no records" << std::endl;
+		return ;
+	}
+
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "span       " << wallTime(trace, begin) << " ~ " << wallTime(trace, end)
+		<< " (" << (end - begin) / 1e9 << " s, " << trace.header.reactorCount << " reactors)" << std::endl;
+	std::cout << "events    ";
+	for (size_t i = 1; i < TRACE_EVENTS; i++)
+		std::cout << " " << eventName[i] << "=" << counts[i];
+	std::cout << std::endl;
+	std::cout << "io         read " << bytesIn << " bytes, sent " << bytesOut << " bytes, "
+		<< partial << " partial sends, " << sendFailed << " failed sends" << std::endl;
+	std::cout << "closes    ";
+	for (size_t i = 0; i < CLOSE_REASONS; i++) {
+		if (closes[i] != 0)
+			std::cout << " " << closeName[i] << "=" << closes[i];
+	}
+	std::cout << std::endl;
+
+	std::cout << std::left << std::setw(12) << "command" << std::right << std::setw(10) << "calls"
+		<< std::setw(12) << "avg us" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "max us" << std::endl;
+	for (std::map<std::string, std::vector<unsigned long> >::iterator it = commands.begin(); it != commands.end(); it++) {
+		std::vector<unsigned long>& values = it->second;
+		double sum = 0;
+
+		for (size_t i = 0; i < values.size(); i++)
+			sum += values[i];
+		std::cout << std::left << std::setw(12) << it->first << std::right << std::setw(10) << values.size()
+			<< std::setw(12) << sum / values.size() / 1000.0 << std::setw(12) << percentile(values, 0.5) / 1000.0
+			<< std::setw(12) << percentile(values, 0.99) / 1000.0 << std::setw(12) << values.back() / 1000.0 << std::endl;
+	}
+
+	if (loops.empty())
+		return ;
+	std::cout << "loops      " << loops.size() << ", busy avg " << busy / 1000.0 / loops.size() << "us" << std::endl;
+	std::sort(loops.begin(), loops.end(), slower);
+	for (size_t i = 0; i < loops.size() && i < SLOWEST_LOOPS; i++)
+		std::cout << "  slowest  " << wallTime(trace, loops[i]->time) << " r" << static_cast<int>(loops[i]->reactor)
+			<< " " << describe(trace, *loops[i]) << std::endl;
+}
+
+int main(int ac, char* av[]) {
+	Options options;
+	Trace trace;
+
+	if (!parseOptions(ac, av, options)) {
+		usage();
+		return 1;
+	}
+	try {
+		load(options.path, trace);
+	} catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	if (!options.aggregateOnly) {
+		printTimeline(options, trace);
+		std::cout << std::endl;
+	}
+	printAggregate(options, trace);
+	return 0;
+}
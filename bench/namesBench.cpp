@@ -0,0 +1,121 @@
+#include "Client.hpp"
+#include "ClientTable.hpp"
+#include "Channel.hpp"
+#include "utils.hpp"
+#include "NickIndex.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+/**
+ * 큰 채널에서 가입과 탈퇴가 번갈아 일어날 때 NAMES 목록을 준비하는 비용을 가입자 수(100 ~ 10,000)를 바꿔가며 잰다.
+ * 사용법 : ./bench/namesBench [churns per size]
+ * rebuild : 예전 getStrUserList처럼 가입할 때마다 명단 전체를 += 로 다시 이어 붙인다(한 줄, 512바이트 제한 없음)
+ * cache   : 탈퇴, 가입이 캐시의 조각 하나만 고치고, 가입자는 만들어진 조각을 그대로 받는다
+ * 가입자 fd는 /dev/null을 열어서 만든다(보내지는 않는다).
+ */
+
+# define CNT_CHURN 20000 // 크기마다 탈퇴 + 가입 횟수
+
+static double now() {
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+}
+
+static void report(size_t members, char const* phase, double elapsed, long churns, size_t lines) {
+	std::cout << std::right << std::setw(6) << members << " members  " << std::left << std::setw(9) << phase
+		<< std::right << std::fixed << std::setprecision(1) << std::setw(12) << elapsed / churns << " ns/join"
+		<< std::setw(6) << lines << " lines" << std::endl;
+}
+
+// 바꾸기 전의 Channel::getStrUserList
+static std::string legacyUserList(Channel const& channel, Client const* op) {
+	std::string list = "";
+
+	if (op)
+		list = "@" + op->getNick() + " ";
+	for (hdlmap::const_iterator it = channel.getUserList().begin(); it != channel.getUserList().end(); it++)
+		if (it->second != op)
+			list += it->second->getNick() + " ";
+	if (list[list.size() - 1] == ' ')
+		list = list.substr(0, list.size() - 1);
+	return list;
+}
+
+static void benchSize(size_t size, long churns) {
+	ClientTable table;
+	NickIndex nickIndex;
+	std::vector<Client*> clients;
+	Channel* channel;
+	volatile size_t sink = 0;
+	size_t lines = 0;
+	double start;
+	in_addr addr;
+
+	addr.s_addr = htonl(INADDR_LOOPBACK);
+	for (size_t i = 0; i < size; i++) {
+		int fd = open("/dev/null", O_RDONLY);
+		std::ostringstream nick;
+
+		if (fd == SYS_FAILURE || (clients.push_back(table.create(fd, addr, 0)), clients.back() == NULL))
+			throw std::runtime_error("Error : client (raise ulimit -n)");
+		clients.back()->setNickIndex(&nickIndex);
+		nick << "u" << i;
+		clients.back()->setNick(nick.str());
+	}
+	channel = new Channel("#bench", clients[0]);
+	for (size_t i = 0; i < size; i++)
+		clients[i]->joinChannel(channel, "");
+
+	// 운영자는 남겨두고 나머지 가입자 중 하나가 나갔다가 다시 들어온다
+	start = now();
+	for (long r = 0; r < churns; r++) {
+		Client* client = clients[1 + r % (size - 1)];
+
+		channel->deleteClientList(client);
+		channel->addClientList(client);
+		sink += legacyUserList(*channel, clients[0]).size();
+	}
+	report(size, "rebuild", now() - start, churns, 1);
+
+	start = now();
+	for (long r = 0; r < churns; r++) {
+		Client* client = clients[1 + r % (size - 1)];
+
+		channel->deleteClientList(client);
+		channel->addClientList(client);
+		sink += channel->getNames().size();
+	}
+	for (size_t i = 0; i < channel->getNames().size(); i++)
+		if (!channel->getNames()[i].empty())
+			lines++;
+	report(size, "cache", now() - start, churns, lines);
+
+	for (size_t i = 0; i < clients.size(); i++)
+		table.destroy(clients[i]->getClientFd());
+	delete channel;
+}
+
+int main(int ac, char* av[]) {
+	static size_t const sizes[] = { 100, 1000, 10000 };
+	long churns = ac > 1 ? std::atol(av[1]) : CNT_CHURN;
+	struct rlimit limit;
+
+	// 가입자 10,000명을 만들 수 있게 fd 상한을 올린다
+	getrlimit(RLIMIT_NOFILE, &limit);
+	limit.rlim_cur = limit.rlim_max;
+	setrlimit(RLIMIT_NOFILE, &limit);
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+		benchSize(sizes[i], churns);
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include "Message.hpp"
+#include "utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <sys/time.h>
+
+/**
+ * 메세지 한 줄을 파싱하는 데 드는 시간을 예전 istringstream 파서와 Message::parse로 나눠서 잰다.
+ * 사용법 : ./bench/parserBench [rounds]
+ * 줄 종류마다 따로 재고, 두 파서가 같은 인자 개수를 내는지도 확인한다.
+ */
+
+# define CNT_ROUND 200000
+
+static double now() {
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+}
+
+// 바꾸기 전 Message::parsMessage를 그대로 옮긴 것 (prefix를 모르고, 매 줄마다 문자열을 새로 만든다)
+static void legacyParse(StrView const& origin, mesvec& comMes) {
+	comMes.clear();
+
+	bool first = true;
+	std::istringstream str;
+	std::string tmp = "";
+
+	str.str(std::string(origin.data, origin.size));
+
+	while (std::getline(str, tmp, ' ')) {
+		if (first) {
+			if (tmp.empty() || chkForbiddenChar(tmp, "\r\n\0"))
+				break ;
+			else
+				comMes.push_back(tmp);
+			first = false;
+		}
+		else {
+			if (tmp.empty())
+				continue ;
+			else if (tmp[0] == ':') {
+				comMes.push_back(tmp.substr(1, tmp.size()));
+				break;
+			}
+			else {
+				if (!chkForbiddenChar(tmp, ":\r\n\0"))
+					comMes.push_back(tmp);
+				else
+					break;
+			}
+		}
+	}
+
+	tmp = "";
+	str >> tmp;
+	if (tmp != "")
+		comMes[comMes.size() - 1] += " " + tmp;
+}
+
+static void report(char const* name, char const* parser, double elapsed, long lines) {
+	std::cout << std::left << std::setw(10) << name << std::setw(8) << parser
+		<< std::right << std::fixed << std::setprecision(1) << std::setw(10) << elapsed / lines << " ns/line" << std::endl;
+}
+
+int main(int ac, char* av[]) {
+	static char const* lines[][2] = {
+		{ "ping", "PING irc.example.net" },
+		{ "privmsg", "PRIVMSG #channel :hello there, this is a fairly ordinary chat line" },
+		{ "user", "USER guest 0 * :Real Name Here" },
+		{ "mode", "MODE #channel +kl secret 42" },
+		{ "join", "JOIN #a,#b,#c,#d key1,key2" },
+	};
+	long rounds = ac > 1 ? std::atol(av[1]) : CNT_ROUND;
+	mesvec legacy;
+	Message message;
+	size_t sink = 0;
+
+	for (size_t k = 0; k < sizeof(lines) / sizeof(lines[0]); k++) {
+		StrView line(lines[k][1], strlen(lines[k][1]));
+		double start;
+
+		legacyParse(line, legacy);
+		message.parse(line);
+		if (legacy.size() != message.size())
+			std::cout << lines[k][0] << " : parser mismatch (" << legacy.size() << " != " << message.size() << ")" << std::endl;
+
+		start = now();
+		for (long i = 0; i < rounds; i++) {
+			legacyParse(line, legacy);
+			sink += legacy.size();
+		}
+		report(lines[k][0], "legacy", now() - start, rounds);
+
+		start = now();
+		for (long i = 0; i < rounds; i++) {
+			message.parse(line);
+			sink += message.size();
+		}
+		report(lines[k][0], "view", now() - start, rounds);
+	}
+	// 최적화로 루프가 지워지지 않게 결과를 쓴다
+	return sink == 0;
+}
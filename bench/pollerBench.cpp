@@ -0,0 +1,204 @@
+#include "Poller.hpp"
+#include "utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+/**
+ * poller 백엔드별로 accept, read, write 이벤트 하나를 꺼내서 처리하는 데 드는 시간을 잰다.
+ * 사용법 : ./bench/pollerBench [epoll|kqueue ...]
+ * 인자가 없으면 이번 빌드에 들어간 백엔드를 전부 잰다.
+ * 백엔드는 빌드할 때 하나만 들어가므로(USE_EPOLL, USE_KQUEUE), 둘을 비교하려면 같은 기계에서
+ * make fclean; make POLLER=epoll bench 와 make fclean; make POLLER=kqueue bench 로 각각 빌드해서 돌리고 ns/event 줄끼리 비교한다.
+ * 첫 줄에 이번 빌드의 백엔드를 찍어서 결과가 어느 빌드의 것인지 남긴다.
+ */
+
+# define CNT_PAIR 256 // 등록해 둘 소켓 쌍 개수
+# define CNT_READY 64 // 한 라운드에 준비 상태로 만들 소켓 개수
+# define CNT_ROUND 2000
+
+static double now() {
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+}
+
+static void setNonBlock(int fd) {
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+static void report(char const* backend, char const* phase, double elapsed, long events) {
+	std::cout << std::left << std::setw(8) << backend << std::setw(8) << phase
+		<< std::right << std::setw(10) << events << " events "
+		<< std::fixed << std::setprecision(1) << std::setw(10) << elapsed / events << " ns/event" << std::endl;
+}
+
+// CNT_PAIR개의 소켓 중 CNT_READY개에 1바이트씩 쓰고, 읽기 이벤트를 꺼내 recv 하는 시간
+static void benchRead(Poller& poller, char const* name) {
+	int pairs[CNT_PAIR][2];
+	PollEvent events[MAX_EVENTS_PER_WAKEUP];
+	char c = 'x';
+	double elapsed = 0;
+	long handled = 0;
+
+	for (int i = 0; i < CNT_PAIR; i++) {
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, pairs[i]) == SYS_FAILURE)
+			throw std::runtime_error("Error : socketpair");
+		setNonBlock(pairs[i][0]);
+		poller.add(pairs[i][0], POLLER_READ);
+	}
+	for (int round = 0; round < CNT_ROUND; round++) {
+		for (int i = 0; i < CNT_READY; i++)
+			send(pairs[(round * 7 + i * 3) % CNT_PAIR][1], &c, 1, 0);
+
+		double start = now();
+		int left = CNT_READY;
+		while (left > 0) {
+			int cnt = poller.wait(events, MAX_EVENTS_PER_WAKEUP, 1000);
+			for (int i = 0; i < cnt; i++) {
+				char buf[16];
+				if (events[i].events & POLLER_READ)
+					left -= recv(events[i].fd, buf, sizeof(buf), 0);
+			}
+			handled += cnt;
+		}
+		elapsed += now() - start;
+	}
+	report(name, "read", elapsed, handled);
+	for (int i = 0; i < CNT_PAIR; i++) {
+		poller.remove(pairs[i][0]);
+		close(pairs[i][0]);
+		close(pairs[i][1]);
+	}
+}
+
+// 항상 쓰기 가능한 소켓에 쓰기 관심을 켰다 껐다 하며 쓰기 이벤트를 꺼내는 시간
+static void benchWrite(Poller& poller, char const* name) {
+	int pairs[CNT_PAIR][2];
+	PollEvent events[MAX_EVENTS_PER_WAKEUP];
+	double elapsed = 0;
+	long handled = 0;
+
+	for (int i = 0; i < CNT_PAIR; i++) {
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, pairs[i]) == SYS_FAILURE)
+			throw std::runtime_error("Error : socketpair");
+		poller.add(pairs[i][0], 0);
+	}
+	for (int round = 0; round < CNT_ROUND; round++) {
+		int armed[CNT_READY];
+
+		for (int i = 0; i < CNT_READY; i++) {
+			armed[i] = pairs[(round * 5 + i * 3) % CNT_PAIR][0];
+			poller.modify(armed[i], POLLER_WRITE);
+		}
+
+		double start = now();
+		int left = CNT_READY;
+		while (left > 0) {
+			int cnt = poller.wait(events, MAX_EVENTS_PER_WAKEUP, 1000);
+			for (int i = 0; i < cnt; i++) {
+				if (events[i].events & POLLER_WRITE) {
+					poller.modify(events[i].fd, 0);
+					left--;
+				}
+			}
+			handled += cnt;
+		}
+		elapsed += now() - start;
+	}
+	report(name, "write", elapsed, handled);
+	for (int i = 0; i < CNT_PAIR; i++) {
+		poller.remove(pairs[i][0]);
+		close(pairs[i][0]);
+		close(pairs[i][1]);
+	}
+}
+
+// 루프백 리슨 소켓에 CNT_READY개씩 접속시키고 읽기 이벤트를 받아 accept 하는 시간
+static void benchAccept(Poller& poller, char const* name) {
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	PollEvent events[MAX_EVENTS_PER_WAKEUP];
+	double elapsed = 0;
+	int listenSocket = socket(PF_INET, SOCK_STREAM, 0);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+	if (bind(listenSocket, (struct sockaddr*)&addr, sizeof(addr)) == SYS_FAILURE
+		|| listen(listenSocket, CONNECT) == SYS_FAILURE
+		|| getsockname(listenSocket, (struct sockaddr*)&addr, &len) == SYS_FAILURE)
+		throw std::runtime_error("Error : listen");
+	setNonBlock(listenSocket);
+	poller.add(listenSocket, POLLER_READ);
+
+	for (int round = 0; round < CNT_ROUND / 10; round++) {
+		std::vector<int> fds;
+
+		for (int i = 0; i < CNT_READY; i++) {
+			int fd = socket(PF_INET, SOCK_STREAM, 0);
+			connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+			fds.push_back(fd);
+		}
+
+		double start = now();
+		int left = CNT_READY;
+		while (left > 0) {
+			int cnt = poller.wait(events, MAX_EVENTS_PER_WAKEUP, 1000);
+			for (int i = 0; i < cnt; i++) {
+				int fd;
+				while ((fd = accept(events[i].fd, NULL, NULL)) != SYS_FAILURE) {
+					fds.push_back(fd);
+					left--;
+				}
+			}
+		}
+		elapsed += now() - start;
+		for (size_t i = 0; i < fds.size(); i++)
+			close(fds[i]);
+	}
+	report(name, "accept", elapsed, (CNT_ROUND / 10) * CNT_READY);
+	poller.remove(listenSocket);
+	close(listenSocket);
+}
+
+int main(int ac, char* av[]) {
+	std::vector<std::string> backends;
+
+	for (int i = 1; i < ac; i++)
+		backends.push_back(av[i]);
+	if (backends.empty()) {
+		backends.push_back("epoll");
+		backends.push_back("kqueue");
+	}
+
+	Poller* defaultPoller = Poller::create();
+	std::cout << "build backend : " << defaultPoller->getName() << std::endl;
+	delete defaultPoller;
+
+	for (size_t i = 0; i < backends.size(); i++) {
+		Poller* poller;
+
+		try {
+			poller = Poller::create(backends[i]);
+		} catch (std::exception& e) {
+			std::cout << std::left << std::setw(8) << backends[i] << "not available in this build" << std::endl;
+			continue ;
+		}
+		benchAccept(*poller, poller->getName());
+		benchRead(*poller, poller->getName());
+		benchWrite(*poller, poller->getName());
+		delete poller;
+	}
+	return 0;
+}
@@ -0,0 +1,161 @@
+#include "Poller.hpp"
+#include "utils.hpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+/**
+ * ircserv에 연결을 여러 개 맺고 PING을 window개씩 겹쳐 보내며 초당 PONG 수를 잰다.
+ * 사용법 : ./bench/reactorBench <port> <password> [connections] [seconds] [threads] [window]
+ * bench/reactorScaling.sh가 reactor 수를 바꿔가며 이 프로그램을 돌린다.
+ */
+
+struct Conn {
+	int fd;
+	bool ready;
+	std::string in;
+};
+
+struct Worker {
+	pthread_t thread;
+	int id;
+	int port;
+	std::string password;
+	int connections;
+	int window;
+	long pongs;
+};
+
+static volatile bool measuring = false;
+static volatile bool finished = false;
+static volatile int readyCount = 0;
+
+static void sendAll(int fd, std::string const& data) {
+	size_t off = 0;
+
+	while (off < data.size()) {
+		ssize_t n = send(fd, data.data() + off, data.size() - off, 0);
+		if (n > 0)
+			off += n;
+		else if (n == SYS_FAILURE && errno != EAGAIN)
+			return ;
+	}
+}
+
+static int connectTo(int port) {
+	struct sockaddr_in addr;
+	int fd = socket(PF_INET, SOCK_STREAM, 0);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = htons(port);
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == SYS_FAILURE)
+		throw std::runtime_error("Error : connect");
+	fcntl(fd, F_SETFL, O_NONBLOCK);
+	return fd;
+}
+
+static void* workerMain(void* arg) {
+	Worker* w = static_cast<Worker*>(arg);
+	Poller* poller = Poller::create();
+	std::map<int, Conn> conns;
+	PollEvent events[MAX_EVENTS_PER_WAKEUP];
+	std::string host;
+
+	for (int i = 0; i < w->connections; i++) {
+		std::ostringstream reg;
+		Conn conn;
+
+		conn.fd = connectTo(w->port);
+		conn.ready = false;
+		reg << "PASS " << w->password << "\r\nNICK b" << w->id << "x" << i << "\r\nUSER bench h s :bench\r\n";
+		sendAll(conn.fd, reg.str());
+		conns[conn.fd] = conn;
+		poller->add(conn.fd, POLLER_READ);
+	}
+
+	while (!finished) {
+		int cnt = poller->wait(events, MAX_EVENTS_PER_WAKEUP, 100);
+
+		for (int i = 0; i < cnt; i++) {
+			Conn& conn = conns[events[i].fd];
+			char buf[8192];
+			ssize_t n;
+			size_t pos;
+
+			while ((n = recv(conn.fd, buf, sizeof(buf), 0)) > 0)
+				conn.in.append(buf, n);
+			while ((pos = conn.in.find("\r\n")) != std::string::npos) {
+				std::string line = conn.in.substr(0, pos);
+
+				conn.in.erase(0, pos + 2);
+				if (!conn.ready && line.find(" 001 ") != std::string::npos) {
+					// 환영 메세지의 prefix가 곧 서버 호스트명. PING은 이 이름으로 보내야 PONG이 온다
+					host = line.substr(1, line.find(' ') - 1);
+					conn.ready = true;
+					__sync_add_and_fetch(&readyCount, 1);
+					for (int k = 0; k < w->window; k++)
+						sendAll(conn.fd, "PING " + host + "\r\n");
+				} else if (line.find(" PONG ") != std::string::npos) {
+					if (measuring)
+						w->pongs++;
+					sendAll(conn.fd, "PING " + host + "\r\n");
+				}
+			}
+		}
+	}
+	for (std::map<int, Conn>::iterator it = conns.begin(); it != conns.end(); it++)
+		close(it->first);
+	delete poller;
+	return NULL;
+}
+
+int main(int ac, char* av[]) {
+	if (ac < 3) {
+		std::cerr << "Usage : ./bench/reactorBench <port> <password> [connections] [seconds] [threads] [window]" << std::endl;
+		return 1;
+	}
+	int port = std::atoi(av[1]);
+	int connections = ac > 3 ? std::atoi(av[3]) : 200;
+	int seconds = ac > 4 ? std::atoi(av[4]) : 5;
+	int threads = ac > 5 ? std::atoi(av[5]) : 4;
+	int window = ac > 6 ? std::atoi(av[6]) : 8;
+	std::vector<Worker> workers(threads);
+	long total = 0;
+
+	for (int i = 0; i < threads; i++) {
+		workers[i].id = i;
+		workers[i].port = port;
+		workers[i].password = av[2];
+		workers[i].connections = connections / threads;
+		workers[i].window = window;
+		workers[i].pongs = 0;
+		pthread_create(&workers[i].thread, NULL, &workerMain, &workers[i]);
+	}
+
+	// 모든 연결이 등록을 마친 뒤부터 잰다
+	for (int i = 0; i < 100 && readyCount < (connections / threads) * threads; i++)
+		usleep(100000);
+	measuring = true;
+	sleep(seconds);
+	measuring = false;
+	finished = true;
+	for (int i = 0; i < threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		total += workers[i].pongs;
+	}
+	std::cout << "connections " << readyCount << " : " << total / seconds << " msgs/sec" << std::endl;
+	return 0;
+}
@@ -0,0 +1,21 @@
+#!/bin/sh
+# reactor 수를 바꿔가며 ircserv의 초당 처리량을 잰다.
+# 사용법 : ./bench/reactorScaling.sh [port] [connections] [seconds] ["1 2 4 8 16"]
+# make && make bench 이후에 저장소 루트에서 실행한다.
+
+PORT=${1:-6697}
+CONNECTIONS=${2:-400}
+SECONDS_PER_RUN=${3:-5}
+REACTORS=${4:-"1 2 4 8 16"}
+PASSWORD=bench
+
+for T in $REACTORS; do
+	./ircserv "$PORT" "$PASSWORD" -t "$T" > /dev/null 2>&1 &
+	PID=$!
+	sleep 1
+	printf "reactors %-3s " "$T"
+	./bench/reactorBench "$PORT" "$PASSWORD" "$CONNECTIONS" "$SECONDS_PER_RUN" 4 8
+	kill "$PID"
+	wait "$PID" 2> /dev/null
+	PORT=$((PORT + 1))
+done
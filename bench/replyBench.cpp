@@ -0,0 +1,300 @@
+#include "reply.hpp"
+#include "error.hpp"
+#include "Payload.hpp"
+#include "utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <sys/time.h>
+
+/**
+ * reply::, error::의 응답 생성 함수 전부를 예전 방식(operator+로 문자열을 만든 뒤 송신 큐로 복사)과
+ * 지금 방식(ReplyFormat으로 Payload에 바로 쓰기)으로 나눠서 잰다.
+ * 사용법 : ./bench/replyBench [rounds]
+ * 두 방식이 같은 바이트를 만드는지도 함수마다 확인한다.
+ */
+
+# define CNT_ROUND 200000
+
+// 바꾸기 전의 source/utils/reply.cpp, error.cpp를 그대로 옮긴 것
+namespace legacy {
+	std::string const suffix = "\r\n";
+
+	namespace reply {
+		std::string const RPL_WELCOME(std::string const& server_host, std::string const& nick, std::string const& user, std::string const& host) {
+			return ":" + server_host + " 001 " + nick + " :Welcome to the Internet Relay Network " + nick + "!" + user + "@" + host + suffix;
+		}
+
+		std::string const RPL_YOURHOST(std::string const& server_host, std::string const& nick, std::string const& version) {
+			return ":" + server_host + " 002 " + nick + " :Your host is " + server_host + ", running version " + version + suffix;
+		}
+
+		std::string const RPL_CREATED(std::string const& server_host, std::string const& nick, std::string const& date) {
+			return ":" + server_host + " 003 " + nick + " :This server was created " + date + suffix;
+		}
+
+		std::string const RPL_MYINFO(std::string const& server_host, std::string const& nick, std::string const& version, std::string const& usermode, std::string const& chanmode) {
+			return ":" + server_host + " 004 " + nick + " :" + server_host + " " + version + " " + usermode + " " + chanmode + suffix;
+		}
+
+		std::string const RPL_ISUPPORT(std::string const& server_host, std::string const& nick) {
+			return ":" + server_host + " 005 " + nick + " :CASEMAPPING=rfc1459 CHANMODES=i,t,k,o,l CHANTYPES=&# CHARSET=ascii MASCHANNELS=10 MAXNICKLEN=9" + suffix; 
+		}
+
+		std::string const RPL_MOTDSTART(std::string const& server_host, std::string const& nick) {
+			return ":" + server_host + " 375 " + nick + " :- " + server_host + " Message of the day - " + suffix;
+		}
+
+		std::string const RPL_MOTD(std::string const& server_host, std::string const& nick, std::string const& line) {
+			return ":" + server_host + " 372 " + nick + " :" + line + suffix;
+		}
+
+		std::string const RPL_ENDOFMOTD(std::string const& server_host, std::string const& nick) {
+			return ":" + server_host + " 376 " + nick + " :End of /MOTD command." + suffix;
+		}
+
+		std::string const RPL_CHANNELMODEIS(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& mode, std::string const& argument) {
+			return ":" + serverHost + " 324 " + nick + " " + chName + " " + mode + " " + argument + suffix;
+		}
+
+		std::string const RPL_CREATIONTIME(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& time) {
+			return ":" + serverHost + " 329 " + nick + " " + chName + " :" + time + suffix; // 원래는 CRLF가 빠져 있었다
+		}
+
+		std::string const RPL_SUCCESSMODE(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName, std::string const& mode, std::string const& argument) {
+			return ":" + nick + "!" + user + "@" + host + " MODE " + chName + " " + mode + " " + argument + suffix;
+		}
+
+		std::string const RPL_SUCCESSJOIN(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName) {
+			return ":" + nick + "!" + user + "@" + host + " JOIN " + chName + " :" + chName + suffix;
+		}
+
+		std::string const RPL_TOPIC(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& topic) {
+			return ":" + serverHost + " 332 " + nick + " " + chName + " :" + topic + suffix;
+		}
+
+		std::string const RPL_NAMREPLY(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& userList) {
+			return ":" + serverHost + " 353 " + nick + " = " + chName + " :" + userList + suffix;
+		}
+
+		std::string const RPL_ENDOFNAMES(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 366 " + nick + " " + chName + " :End of /NAMES list." + suffix;
+		}
+
+		std::string const RPL_SUCCESSQUIT(std::string const& nick, std::string const& user, std::string const& host, std::string const& reason) {
+			return ":" + nick + "!" + user + "@" + host + " QUIT :Quit: " + reason + suffix;
+		}
+
+		// PRIVMSG, NOTICE 공용. command에 둘 중 하나를 넘긴다
+		std::string const RPL_PRIVMSG(std::string const& nick, std::string const& user, std::string const& host, std::string const& command, std::string const& target, std::string const& text) {
+			return ":" + nick + "!" + user + "@" + host + " " + command + " " + target + " :" + text + suffix;
+		}
+
+		// 조용한 클라이언트에게 서버가 먼저 보내는 PING
+		std::string const RPL_PING(std::string const& serverHost) {
+			return "PING :" + serverHost + suffix;
+		}
+
+		// 원래는 CommandExecute::pong 안에서 바로 이어 붙였다
+		std::string const RPL_PONG(std::string const& serverHost) {
+			return ":" + serverHost + " PONG " + serverHost + " :" + serverHost + suffix;
+		}
+	}
+
+	namespace error {
+		std::string const ERR_INPUTTOOLONG(std::string const& serverHost) {
+			return ":" + serverHost + " 417 :Input line was too long" + suffix;
+		}
+
+		std::string const ERR_NEEDMOREPARAMS(std::string const& serverHost, std::string const& command) {
+			return ":" + serverHost + " 461 " + command + " :Not enough parameters" + suffix;
+		}
+
+		std::string const ERR_ALREADYREGISTERED(std::string const& serverHost) {
+			return ":" + serverHost + " 462 :You may not reregister" + suffix;
+		}
+
+		std::string const ERR_PASSWDMISMATCH(std::string const& serverHost) {
+			return ":" + serverHost + " 464 :Password incorrect" + suffix;
+		}
+
+		std::string const ERR_NONICKNAMEGIVEN(std::string const& serverHost) {
+			return ":" + serverHost + " 431 :No nickname given" + suffix;
+		}
+
+		std::string const ERR_NICKNAMEINUSE(std::string const& serverHost, std::string const& nick) {
+			return ":" + serverHost + " 433 " + nick + " :Nickname is already in use" + suffix;
+		}
+
+		std::string const ERR_ERRONEUSNICKNAME(std::string const& serverHost, std::string const& nick) {
+			return ":" + serverHost + " 432 " + nick + " :Erroneus nickname" + suffix;
+		}
+
+		std::string const ERR_NOTREGISTERED(std::string const& serverHost, std::string const& reason) {
+			return ":" + serverHost + " 451 :" + reason + suffix;
+		}
+
+		std::string const ERR_UNKNOWNCOMMAND(std::string const& serverHost, std::string const& command) {
+			return ":" + serverHost + " 421 " + command + " :Unknown Command" + suffix;
+		}
+
+		std::string const ERR_NOORIGIN(std::string const& serverHost, std::string const& nick) {
+			return ":" + serverHost + " 409 " + nick + " :No origin specified" + suffix;
+		}
+
+		std::string const ERR_INVALIDMODEPARAM(std::string const& serverHost, std::string const& nick, std::string const& chName, char const& mode, std::string const& reason) {
+			return ":" + serverHost + " 696 " + nick + " " + chName + " " + mode + " :" + reason + suffix;
+		}
+
+		std::string const ERR_UNKNOWNMODE(std::string const& serverHost, std::string const& nick, char const& mode) {
+			return ":" + serverHost + " 472 " + nick + " " + mode + " :is not a recognised channel mode" + suffix;
+		}
+
+		std::string const ERR_NOSUCHCHANNEL(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 403 " + nick + " " + chName + " :No such channel" + suffix;
+		}
+
+		std::string const ERR_CHANOPRIVSNEEDED(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 482 " + nick + " " + chName + " :You're not channel operator" + suffix;
+		}
+
+		std::string const ERR_BADCHANMASK(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 476 " + nick + " " + chName + " :Bad Channel Mask" + suffix;
+		}
+
+		std::string const ERR_TOOMANYCHANNELS(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 405 " + nick + " " + chName + " :You have joined too many channels" + suffix;
+		}
+
+		std::string const ERR_CHANNELISFULL(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 471 " + nick + " " + chName + " :Cannot join channel (+l)" + suffix;
+		}
+
+		std::string const ERR_INVITEONLYCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 473 " + nick + " " + chName + " :Cannot join channel (+i)" + suffix;
+		}
+
+		std::string const ERR_BADCHANNELKEY(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 475 " + nick + " " + chName + " :Cannot join channel (+k)" + suffix;
+		}
+
+		std::string const ERR_NOSUCHNICK(std::string const& serverHost, std::string const& nick, std::string const& target) {
+			return ":" + serverHost + " 401 " + nick + " " + target + " :No such nick/channel" + suffix;
+		}
+
+		std::string const ERR_CANNOTSENDTOCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+			return ":" + serverHost + " 404 " + nick + " " + chName + " :Cannot send to channel" + suffix;
+		}
+
+		std::string const ERR_NORECIPIENT(std::string const& serverHost, std::string const& nick, std::string const& command) {
+			return ":" + serverHost + " 411 " + nick + " :No recipient given (" + command + ")" + suffix;
+		}
+
+		std::string const ERR_NOTEXTTOSEND(std::string const& serverHost, std::string const& nick) {
+			return ":" + serverHost + " 412 " + nick + " :No text to send" + suffix;
+		}
+
+		std::string const ERROR_CLOSINGLINK(std::string const& host, std::string const& reason) {
+			return "ERROR :Closing Link: " + host + " (" + reason + ")" + suffix;
+		}
+	}
+}
+
+static double now() {
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+}
+
+static volatile size_t sink = 0;
+
+static void report(char const* name, double legacyElapsed, double formatElapsed, long rounds, bool same) {
+	std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(9) << legacyElapsed / rounds << " ns"
+		<< std::setw(9) << formatElapsed / rounds << " ns"
+		<< std::setw(7) << std::setprecision(2) << legacyElapsed / formatElapsed << "x"
+		<< (same ? "" : "  MISMATCH") << std::endl;
+}
+
+// 예전 : 문자열을 만들고 송신 큐(Payload)로 한 번 더 복사. 지금 : Payload에 바로 쓴다
+# define BENCH(ns, name, args) \
+	do { \
+		double start = now(); \
+		for (long i = 0; i < rounds; i++) { \
+			Payload* payload = Payload::create(legacy::ns::name args); \
+			sink += payload->getSize(); \
+			payload->release(); \
+		} \
+		double mid = now(); \
+		for (long i = 0; i < rounds; i++) { \
+			Reply reply = ns::name args; \
+			sink += reply.size(); \
+		} \
+		double end = now(); \
+		report(#name, mid - start, end - mid, rounds, legacy::ns::name args == ns::name args.str()); \
+	} while (0)
+
+int main(int ac, char* av[]) {
+	long rounds = ac > 1 ? std::atol(av[1]) : CNT_ROUND;
+	std::string host = "irc.example.net";
+	std::string nick = "someone";
+	std::string user = "user";
+	std::string chost = "127.0.0.1";
+	std::string chan = "#channel";
+	std::string cmd = "PRIVMSG";
+	std::string ver = "1.0";
+	std::string umode = "x";
+	std::string cmode = "itkol";
+	std::string mode = "+kl";
+	std::string arg = "secret 42";
+	std::string date = "Sat Oct 17 12:00:00 2026";
+	std::string text = "the quick brown fox jumps over the lazy dog";
+	std::string names = "@op alice bob carol dave erin frank grace heidi ivan judy";
+
+	std::cout << std::left << std::setw(22) << "builder" << std::right << std::setw(12) << "legacy" << std::setw(12) << "format" << std::setw(8) << "speedup" << std::endl;
+	BENCH(reply, RPL_WELCOME, (host, nick, user, chost));
+	BENCH(reply, RPL_YOURHOST, (host, nick, ver));
+	BENCH(reply, RPL_CREATED, (host, nick, date));
+	BENCH(reply, RPL_MYINFO, (host, nick, ver, umode, cmode));
+	BENCH(reply, RPL_ISUPPORT, (host, nick));
+	BENCH(reply, RPL_MOTDSTART, (host, nick));
+	BENCH(reply, RPL_MOTD, (host, nick, text));
+	BENCH(reply, RPL_ENDOFMOTD, (host, nick));
+	BENCH(reply, RPL_SUCCESSMODE, (nick, user, chost, chan, mode, arg));
+	BENCH(reply, RPL_CHANNELMODEIS, (host, nick, chan, mode, arg));
+	BENCH(reply, RPL_CREATIONTIME, (host, nick, chan, date));
+	BENCH(reply, RPL_SUCCESSJOIN, (nick, user, chost, chan));
+	BENCH(reply, RPL_TOPIC, (host, nick, chan, text));
+	BENCH(reply, RPL_NAMREPLY, (host, nick, chan, names));
+	BENCH(reply, RPL_ENDOFNAMES, (host, nick, chan));
+	BENCH(reply, RPL_SUCCESSQUIT, (nick, user, chost, text));
+	BENCH(reply, RPL_PING, (host));
+	BENCH(reply, RPL_PONG, (host));
+	BENCH(reply, RPL_PRIVMSG, (nick, user, chost, cmd, chan, text));
+	BENCH(error, ERR_INPUTTOOLONG, (host));
+	BENCH(error, ERR_NEEDMOREPARAMS, (host, cmd));
+	BENCH(error, ERR_ALREADYREGISTERED, (host));
+	BENCH(error, ERR_PASSWDMISMATCH, (host));
+	BENCH(error, ERR_NONICKNAMEGIVEN, (host));
+	BENCH(error, ERR_NICKNAMEINUSE, (host, nick));
+	BENCH(error, ERR_ERRONEUSNICKNAME, (host, nick));
+	BENCH(error, ERR_NOTREGISTERED, (host, text));
+	BENCH(error, ERR_UNKNOWNCOMMAND, (host, cmd));
+	BENCH(error, ERR_NOORIGIN, (host, nick));
+	BENCH(error, ERR_INVALIDMODEPARAM, (host, nick, chan, 'k', text));
+	BENCH(error, ERR_UNKNOWNMODE, (host, nick, 'z'));
+	BENCH(error, ERR_NOSUCHCHANNEL, (host, nick, chan));
+	BENCH(error, ERR_CHANOPRIVSNEEDED, (host, nick, chan));
+	BENCH(error, ERR_BADCHANMASK, (host, nick, chan));
+	BENCH(error, ERR_TOOMANYCHANNELS, (host, nick, chan));
+	BENCH(error, ERR_CHANNELISFULL, (host, nick, chan));
+	BENCH(error, ERR_INVITEONLYCHAN, (host, nick, chan));
+	BENCH(error, ERR_BADCHANNELKEY, (host, nick, chan));
+	BENCH(error, ERR_NOSUCHNICK, (host, nick, chan));
+	BENCH(error, ERR_CANNOTSENDTOCHAN, (host, nick, chan));
+	BENCH(error, ERR_NORECIPIENT, (host, nick, cmd));
+	BENCH(error, ERR_NOTEXTTOSEND, (host, nick));
+	BENCH(error, ERROR_CLOSINGLINK, (chost, text));
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include "Harness.hpp"
+#include "Logger.hpp"
+#include <iostream>
+
+/**
+ * STATS 권한 확인. bench/Harness.hpp 사용. make check로 돌린다
+ * 1. OPER 전에는 STATS에 481로 답한다
+ * 2. 비밀번호가 틀린 OPER는 464, 맞는 OPER는 381
+ * 3. OPER 뒤에는 STATS에 답하고(242) 219로 끝낸다. OPER하지 않은 다른 클라이언트는 여전히 481
+ * 하나라도 틀리면 1을 돌려준다
+ */
+
+static int failures = 0;
+
+// 보내고 한 바퀴 돌린 뒤, 받은 내용에 numeric(" 481 " 등)이 있는지 본다
+static void expect(Harness& harness, int id, std::string const& line, std::string const& numeric) {
+	std::string out;
+	bool passed;
+
+	harness.send(id, line);
+	harness.step();
+	out = harness.receive(id);
+	passed = out.find(" " + numeric + " ") != std::string::npos;
+	if (!passed)
+		failures++;
+	std::cout << (passed ? "ok     " : "FAILED ") << line << " -> " << numeric << std::endl;
+	if (!passed)
+		std::cout << "       got : " << out;
+}
+
+int main() {
+	int devNull = open("/dev/null", O_WRONLY);
+
+	Logger::start(devNull, LOG_WARN);
+	try {
+		Harness harness;
+		int oper;
+		int user;
+
+		harness.getServer().setOperator("admin", "secret");
+		oper = harness.registerClient("alice");
+		user = harness.registerClient("bob");
+
+		expect(harness, oper, "STATS u", "481");
+		expect(harness, oper, "OPER admin wrong", "464");
+		expect(harness, oper, "STATS u", "481");
+		expect(harness, oper, "OPER admin secret", "381");
+		expect(harness, oper, "STATS u", "242");
+		expect(harness, oper, "STATS m", "219");
+		expect(harness, user, "STATS u", "481");
+	} catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		failures++;
+	}
+	Logger::stop();
+	return failures > 0 ? 1 : 0;
+}
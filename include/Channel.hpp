@@ -5,7 +5,8 @@
 	Channel이 하는 일
 	1. 단일 채널에 필요한 변수 보유
 		a. 채널 운영자 client 포인터
-		b. 채널 소속 인원 목록
+		b. 채널 소속 인원 목록(핸들로 찾는 map과 훑기 위한 배열, NAMES 응답용 조각 캐시)
+			- fd가 아니라 ClientHandle로 기억하므로, 나간 클라이언트의 fd를 새 클라이언트가 받아도 명단이 넘어가지 않는다
 		c. ban 목록... 근데 루프백 IP면 이게 소용이 있나?
 		d. 채널 모드 플래그
 	2. 위 내용물을 볼 수 있는 getter 함수
@@ -15,6 +16,7 @@
 class Client;
 
 # include "./utils/utils.hpp"
+# include "./utils/NamesCache.hpp"
 # include "./Client.hpp"
 
 class Channel {
@@ -25,8 +27,18 @@ private:
 	// 채널 운영자
 	Client* chanOp;
 
-	// 채널 가입자 명단
-	cltmap userList;
+	// 채널 가입자 명단. 핸들 순서(= fd 순서)로 정렬된다
+	hdlmap userList;
+
+	// userList와 같은 가입자를 빈틈없이 모아둔 배열. 메세지를 뿌릴 때는 이걸 훑는다
+	// 순서는 보장하지 않는다(뺄 때 마지막 원소를 빈자리로 옮긴다)
+	cltvec members;
+
+	// 가입자 핸들 -> members 안의 자리. 뺄 때 배열을 훑지 않고 바로 찾는다
+	hdlindex memberSlot;
+
+	// NAMES 응답에 바로 쓸 별칭 목록 조각. 가입, 탈퇴, 별칭 변경, 운영자 변경 때 그 자리만 고친다
+	NamesCache names;
 
 	// 가입자수 상한
 	int userLimit;
@@ -46,8 +58,8 @@ private:
 	// 채널 암호
 	std::string key;
 
-	// 초대자 명단
-	cltmap inviteList;
+	// 초대자 명단. 초대받은 클라이언트가 나가면 핸들이 더는 맞지 않으므로 따로 지우지 않아도 된다
+	hdlset inviteList;
 public:
 	Channel(std::string chName, Client* client);
 	~Channel();
@@ -69,19 +81,25 @@ public:
 	void delInviteList(Client* client);
 	void deleteClientList(Client* client);
 
+	// 가입자의 별칭이 바뀌었을 때(Client::setNick이 부른다)
+	void renameClient(Client* client, std::string const& oldNick);
+
 	// getter
 	Client const& getChanOp() const;
-	cltmap const& getUserList() const;
+	hdlmap const& getUserList() const;
+	cltvec const& getMembers() const;
 	int const getUserLimit() const;
 	std::string const getChName() const;
 	std::string const getTopic() const;
 	int const getMode() const;
 	time_t const getTime() const;
 	std::string const getKey() const;
-	std::string const getStrUserList() const;
+	std::vector<std::string> const& getNames() const;
 
 	// chker
 	bool isClientInvite(Client* client);
+	bool isChanOp(Client const* client) const;
+	bool isMember(Client const* client) const;
 };
 
 #endif
@@ -16,6 +16,11 @@
 # include <unistd.h>
 
 # include "./utils/utils.hpp"
+# include "./utils/RecvBuffer.hpp"
+# include "./utils/LineFramer.hpp"
+# include "./utils/NickIndex.hpp"
+# include "./utils/TimerWheel.hpp"
+# include "./utils/ConnClass.hpp"
 # include "./Channel.hpp"
 
 class Client {
@@ -23,7 +28,7 @@ private:
 	// PASS, NICK, USER 전부를 거쳤는 지 검증. 비트마스킹.
 	int passConnect;
 
-	// ping 검사. ping을 보낼 때 false로 바꾸고 pong을 받으면 true가 된다
+	// ping 검사. ping을 보낼 때 false로 바꾸고, 그 뒤로 무엇이든 받으면 true가 된다
 	bool passPing;
 
 	// 운영자 권한
@@ -35,6 +40,10 @@ private:
 	// client socket
 	int fd;
 
+	// 이 클라이언트를 맡은 reactor 번호와, fd 재사용과 구분하기 위한 핸들(ClientTable이 정한다)
+	int owner;
+	ClientHandle handle;
+
 	// client addr info
 	in_addr info;
 
@@ -56,23 +65,66 @@ private:
 	// 현재 참여하고 있는 채널 목록
 	chlmap joinList;
 
+	// 수신 버퍼. recv가 바로 여기에 쓰고, 완성된 줄은 여기서 바로 파싱한다
+	RecvBuffer recvBuf;
+
+	// 수신 버퍼에서 줄을 잘라내는 프레이머. 지난번에 멈춘 곳을 기억한다
+	LineFramer framer;
+
+	// 서버의 별칭 색인. setNick과 파괴자가 자기 별칭을 넣고 뺀다
+	NickIndex* nickIndex;
+
+	// poller에 쓰기 관심이 켜져 있는지. 송신 큐에 못 보낸 내용이 남아 있는 동안만 켠다
+	bool writeArmed;
+
+	// 송신 큐가 등급의 sendqSoft를 넘어서 읽기 관심을 꺼둔 상태인지
+	bool readPaused;
+
+	// 수신 버퍼에 처리 못 한 줄이 남아서 reactor의 실행 대기열에 올라가 있는지
+	bool runQueued;
+
+	// 흐름 제어 토큰과 마지막으로 채운 시각. 토큰은 명령어 비용만큼 음수까지 내려갈 수 있다
+	int floodTokens;
+	time_t floodStamp;
+
+	// 토큰을 다 써서 읽기를 멈춘 상태인지, 다시 읽을 시각을 거는 타이머
+	bool throttled;
+	TimerNode throttleTimer;
+
+	// 접속한 주소로 정한 등급. 송신 큐 한도 등을 정한다
+	ConnClass const* connClass;
+
+	// reactor의 타이머 휠에 걸리는 마감(등록 시간 초과, PING 보낼 시각, PONG 시간 초과 중 하나)
+	TimerNode timer;
+
 	// 사용 안 함
 	Client();
 	Client(Client const& ref);
 public:
 	// 생성자와 파괴자
-	Client(int fd, in_addr info);
+	Client(int fd, in_addr info, int owner = 0, ClientHandle handle = 0);
 	~Client();
 
 	// setter
 	void setPassPing(bool flag);
 	void setPassConnect(int flag);
+	void setOperator(bool flag);
 	void setNick(std::string nick);
 	void setReal(std::string real);
 	void setHost(std::string host);
 	void setUser(std::string user);
 	void setServ(std::string serv);
 	void setFinalTime();
+	void setNickIndex(NickIndex* index);
+	void setWriteArmed(bool flag);
+	void setReadPaused(bool flag);
+	void setRunQueued(bool flag);
+	void setThrottled(bool flag);
+
+	// 흐름 제어. 토큰을 채운 뒤에 쓰고, 남은 토큰으로 막을지 정한다
+	void chargeFlood(unsigned int cost);
+	bool isFloodLimited();
+	time_t getFloodResumeTime() const;
 
 	// add
 	void addJoinList(Channel* channel);
@@ -85,7 +137,10 @@ public:
 
 	// getter
 	int getPassConnect() const;
+	bool getPassPing() const;
 	int getClientFd() const;
+	int getOwner() const;
+	ClientHandle getHandle() const;
 	bool IsOperator() const;
 	std::string const& getHost() const;
 	std::string const& getNick() const;
@@ -93,6 +148,15 @@ public:
 	std::string const& getUser() const;
 	std::string const& getServ() const;
 	time_t const& getTime() const;
+	RecvBuffer& getRecvBuf();
+	LineFramer& getFramer();
+	bool isWriteArmed() const;
+	bool isReadPaused() const;
+	bool isRunQueued() const;
+	bool isThrottled() const;
+	ConnClass const& getConnClass() const;
+	TimerNode& getTimer();
+	TimerNode& getThrottleTimer();
 };
 
 #endif
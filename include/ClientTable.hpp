@@ -0,0 +1,55 @@
+#ifndef _CLIENTTABLE_HPP_
+# define _CLIENTTABLE_HPP_
+
+# include <vector>
+
+# include "./utils/utils.hpp"
+# include "./Client.hpp"
+
+/*
+	ClientTable이 하는 일
+	1. fd를 그대로 번호로 쓰는 슬롯 배열로 클라이언트를 찾는다(트리를 타지 않는다)
+		a. 슬롯 수는 RLIMIT_NOFILE(최대 MAX_CLIENT_SLOT)로 처음에 정하고 바꾸지 않는다
+	2. Client 객체는 CLIENT_SLAB_SIZE개씩 한 덩어리(slab)로 잡아두고, 빈 자리를 돌려쓴다
+	3. 슬롯마다 세대(generation)를 두고, 클라이언트가 들어올 때마다 올린다
+		a. 핸들 = (슬롯 << 32) | 세대. fd가 재사용되어도 세대가 다르므로 옛 핸들은 아무도 가리키지 않는다
+		b. 채널의 가입자, 초대자 명단과 reactor 우편은 fd 대신 핸들을 쓴다
+		c. 핸들 확인은 슬롯 하나를 보는 O(1)
+	4. 서버 상태 잠금(stateLock) 안에서만 쓴다
+*/
+
+class ClientTable {
+private:
+	struct Slot {
+		Client* client;
+		uint32_t generation;
+	};
+
+	std::vector<Slot> slots;
+
+	// Client 크기의 빈 자리 목록과 그 자리를 잘라낸 덩어리들
+	std::vector<void*> freeList;
+	std::vector<char*> slabs;
+
+	// 사용 안 함
+	ClientTable(ClientTable const& ref);
+	ClientTable& operator=(ClientTable const& ref);
+
+	void* allocate();
+public:
+	ClientTable();
+	~ClientTable();
+
+	// fd 슬롯에 클라이언트를 만든다. 슬롯 범위를 넘는 fd면 NULL
+	Client* create(int fd, in_addr info, int owner);
+	void destroy(int fd);
+
+	Client* find(int fd) const;
+	Client* find(ClientHandle handle) const;
+	size_t capacity() const;
+
+	static ClientHandle makeHandle(int slot, uint32_t generation);
+	static int handleSlot(ClientHandle handle);
+};
+
+#endif
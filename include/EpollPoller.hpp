@@ -0,0 +1,37 @@
+#ifndef _EPOLLPOLLER_HPP_
+# define _EPOLLPOLLER_HPP_
+
+# include "Poller.hpp"
+
+# ifdef USE_EPOLL
+
+# include <sys/epoll.h>
+
+/*
+	Linux용 epoll 백엔드
+	epoll은 관심 이벤트가 커널에 남아있기 때문에 add, modify, remove가 곧바로 epoll_ctl을 호출한다.
+*/
+class EpollPoller : public Poller {
+private:
+	int epfd;
+	struct epoll_event events[MAX_EVENTS_PER_WAKEUP];
+
+	// 사용 안 함
+	EpollPoller(EpollPoller const& ref);
+	EpollPoller& operator=(EpollPoller const& ref);
+
+	static uint32_t toEpoll(int interest);
+public:
+	EpollPoller();
+	~EpollPoller();
+
+	void add(int fd, int interest);
+	void modify(int fd, int interest);
+	void remove(int fd);
+	int wait(PollEvent* out, int maxEvents, int timeout);
+	char const* getName() const;
+};
+
+# endif
+
+#endif
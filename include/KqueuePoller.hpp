@@ -0,0 +1,43 @@
+#ifndef _KQUEUEPOLLER_HPP_
+# define _KQUEUEPOLLER_HPP_
+
+# include "Poller.hpp"
+
+# ifdef USE_KQUEUE
+
+# include <vector>
+# include <sys/types.h>
+# include <sys/event.h>
+# include <sys/time.h>
+
+/*
+	macOS, BSD용 kqueue 백엔드
+	변경 사항은 changeList에 모아두었다가 다음 wait()의 kevent 호출 한 번에 같이 넘긴다.
+	fd를 close하면 kqueue가 알아서 등록을 지우므로, remove는 아직 넘기지 않은 변경 사항만 정리한다.
+*/
+class KqueuePoller : public Poller {
+	typedef std::vector<struct kevent> kquvec;
+private:
+	int kq;
+	kquvec changeList;
+	struct kevent events[MAX_EVENTS_PER_WAKEUP];
+
+	// 사용 안 함
+	KqueuePoller(KqueuePoller const& ref);
+	KqueuePoller& operator=(KqueuePoller const& ref);
+
+	void pushChange(int fd, int16_t filter, uint16_t flags);
+public:
+	KqueuePoller();
+	~KqueuePoller();
+
+	void add(int fd, int interest);
+	void modify(int fd, int interest);
+	void remove(int fd);
+	int wait(PollEvent* out, int maxEvents, int timeout);
+	char const* getName() const;
+};
+
+# endif
+
+#endif
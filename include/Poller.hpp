@@ -0,0 +1,52 @@
+#ifndef _POLLER_HPP_
+# define _POLLER_HPP_
+
+/*
+	Poller가 하는 일
+	1. 운영체제별 I/O 다중화 함수(kqueue, epoll)를 하나의 인터페이스로 감싼다
+		a. fd 당 관심 이벤트는 add()로 한 번만 등록하고, 이후에는 modify()로 변경만 한다
+		b. wait() 한 번에 꺼내오는 이벤트 수는 호출자가 넘긴 상한을 넘지 않는다
+	2. 어떤 백엔드를 쓸 지는 빌드 시점(Makefile의 POLLER 변수)에 결정한다
+		a. Linux -> epoll, 그 외(macOS, BSD) -> kqueue
+*/
+
+# include <string>
+# include <stdint.h>
+
+// 관심 이벤트, 발생 이벤트 비트 마스킹
+# define POLLER_READ (1 << 0)
+# define POLLER_WRITE (1 << 1)
+# define POLLER_ERROR (1 << 2)
+# define POLLER_EOF (1 << 3)
+
+// wait() 한 번에 꺼내올 최대 이벤트 수
+# define MAX_EVENTS_PER_WAKEUP 64
+
+// wait()에서 꺼내온 이벤트 하나
+struct PollEvent {
+	int fd;
+	int events;
+	// kqueue는 읽을 수 있는 바이트 수를 알려주지만, epoll은 알려주지 않으므로 0
+	intptr_t data;
+};
+
+class Poller {
+public:
+	virtual ~Poller();
+
+	// fd 등록, 관심 이벤트 변경, 등록 해제(close 전에 호출). 커널이 거부하면 예외를 던진다
+	virtual void add(int fd, int interest) = 0;
+	virtual void modify(int fd, int interest) = 0;
+	virtual void remove(int fd) = 0;
+
+	// timeout은 밀리초, 음수면 이벤트가 올 때까지 대기. 에러 시 SYS_FAILURE
+	virtual int wait(PollEvent* events, int maxEvents, int timeout) = 0;
+
+	virtual char const* getName() const = 0;
+
+	// 빌드에 포함된 기본 백엔드, 혹은 이름으로 지정한 백엔드 생성
+	static Poller* create();
+	static Poller* create(std::string const& name);
+};
+
+#endif
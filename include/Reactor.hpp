@@ -0,0 +1,170 @@
+#ifndef _REACTOR_HPP_
+# define _REACTOR_HPP_
+
+# include <string>
+# include <vector>
+# include <pthread.h>
+# include <netinet/in.h>
+
+# include "Poller.hpp"
+# include "./utils/utils.hpp"
+# include "./utils/Mutex.hpp"
+# include "./utils/Buffer.hpp"
+# include "./utils/Message.hpp"
+# include "./utils/TimerWheel.hpp"
+# include "./utils/Stats.hpp"
+# include "./utils/Profiler.hpp"
+# include "./utils/FlightRecorder.hpp"
+
+class Server;
+class Client;
+
+/*
+	Reactor가 하는 일
+	1. 스레드 하나가 돌리는 이벤트 루프
+		a. 자신만의 poller와 리슨 소켓(SO_REUSEPORT)을 가진다
+		b. 자신이 accept 한 클라이언트의 읽기, 쓰기, 연결 해제를 전부 맡는다
+		c. 송신 버퍼와 파싱 결과는 reactor마다 따로 가진다(수신 버퍼는 클라이언트마다)
+	2. 다른 reactor의 클라이언트에게 보낼 메세지는 우편함(mailbox)으로 넘긴다
+		a. 명령어 실행 중(서버 상태 잠금 중)에 다른 reactor 소속 클라이언트에게 보내면 forward()가 우편함에 넣는다
+		b. 우편함에 넣은 쪽은 wake 파이프에 1바이트를 써서 주인 reactor를 깨운다
+		c. 주인 reactor는 깨어나면 우편함을 비우면서 자기 클라이언트에게 보낸다
+			(우편에는 Payload 참조만 담긴다. 넣을 때 참조를 늘리고, 보내거나 버린 뒤에 놓는다)
+		d. 그 사이에 클라이언트가 나가고 fd가 재사용되었을 수 있으니 우편에는 fd 대신 ClientHandle을 담아 확인한다
+	3. 채널, 클라이언트 명단 같은 공유 상태는 Server가 갖고, 명령어 실행은 Server의 상태 잠금 안에서 한다
+	4. 클라이언트마다 루프 한 바퀴에 처리할 명령 수와 바이트 수(접속 등급의 lineBudget, byteBudget)를 나눠준다
+		a. 다 쓰고도 수신 버퍼에 줄이 남은 클라이언트는 실행 대기열에 올리고, 다음 바퀴에 차례대로(라운드 로빈) 이어서 처리한다
+		b. 대기열이 비어 있지 않으면 poller는 기다리지 않는다(timeout 0)
+		c. 등록 중이거나 다음 줄이 PING, PONG인 클라이언트는 급한 대기열로 먼저 처리하고, PING, PONG은 명령 수에 세지 않는다
+		d. 대기열에 있는 클라이언트는 읽기 이벤트가 와도 recv만 하고, 처리는 대기열 차례에 한 번만 한다
+	5. 흐름 제어 토큰을 다 쓴 클라이언트는 끊지 않고, 토큰이 찰 시각까지 읽기를 멈춘다(throttleTimer)
+	6. 이벤트, I/O, 명령어 실행 시간을 자기 Stats에 센다. 큐 깊이는 1초에 한 번 클라이언트를 훑어서 적는다
+		a. 큐 깊이를 적을 때 Stats 사본도 떠 둔다. 다른 reactor는 이 사본만 읽는다
+	7. 기록 파일(-T)이 있으면 접속, recv, 명령어, writev, 끊기, 타이머, 바퀴마다 FlightRecorder에 남긴다
+	8. PROFILE로 빌드하면 루프 한 바퀴를 구간(wait, read, parse, dispatch, flush, timers 등)별로 재서 주기적으로 로그에 남긴다
+*/
+class Reactor {
+private:
+	// 다른 reactor가 넘긴 메세지 하나
+	struct Mail {
+		ClientHandle handle;
+		Payload* payload;
+	};
+
+	Server& server;
+	int id;
+	Poller* poller;
+	int listenSocket;
+	pthread_t thread;
+
+	// 이 reactor가 accept 한 클라이언트. fd를 번호로 쓰고, 이 reactor 스레드만 읽고 쓴다
+	cltvec clients;
+
+	// reactor 전용 버퍼와 파싱 컨텍스트
+	Buffer buffer;
+	Message message;
+
+	// 이 reactor 클라이언트들의 마감(등록 시간 초과, PING, PONG 시간 초과)
+	TimerWheel timers;
+
+	// 이 reactor의 계측. 이 스레드만 쓴다
+	Stats stats;
+
+	// 다른 스레드가 읽는 사본. 1초에 한 번 이 스레드가 떠서 publishLock 아래 바꿔 넣는다
+	Stats published;
+	Mutex publishLock;
+
+#ifdef PROFILE
+	// 루프 구간별 시간. 이 스레드만 쓴다
+	Profiler profiler;
+#endif
+
+	// 처리 한도를 다 써서 다음 바퀴로 미룬 클라이언트(급한 쪽, 나머지)
+	std::vector<ClientHandle> urgentQueue;
+	std::vector<ClientHandle> runQueue;
+
+	// 이번 바퀴에 처리할 몫. 대기열과 바꿔치기하며 재사용한다
+	std::vector<ClientHandle> urgentBatch;
+	std::vector<ClientHandle> runBatch;
+
+	// 우편함과 우편함을 깨우는 파이프
+	Mutex mailLock;
+	std::vector<Mail> mailbox;
+	int wakePipe[2];
+
+	// 현재 스레드에서 돌고 있는 reactor
+	static THREAD_LOCAL Reactor* current;
+
+	// 사용 안 함
+	Reactor(Reactor const& ref);
+	Reactor& operator=(Reactor const& ref);
+
+	static void* threadMain(void* arg);
+	void drainMailbox();
+	Client* findClient(int fd) const;
+
+	// 이 reactor 클라이언트들의 송신, 수신 큐 깊이를 Stats에 적는다
+	void sampleDepth();
+
+	// 지금 계측을 다른 스레드가 읽을 사본으로 뜬다
+	void publishStats();
+
+	// 실행 대기열에 올리기, 지난 바퀴에 올라온 클라이언트들 이어서 처리하기
+	void enqueueRun(Client& client);
+	void runQueued(std::vector<ClientHandle> const& batch);
+public:
+	Reactor(Server& server, int id);
+	~Reactor();
+
+	// 리슨 소켓 열기(initDetached는 리슨 소켓 없이), 이벤트 루프
+	void init(int port, bool reusePort);
+	void initDetached();
+	void run();
+
+	// run()을 나눈 것. enter()를 한 번 부른 뒤 runOnce()로 한 바퀴씩 돈다
+	void enter();
+	bool runOnce(bool block);
+
+	// 별도 스레드에서 run() 시작, 종료 대기
+	void start();
+	void join();
+
+	// 클라이언트 생성 및 삭제. attachClient는 이미 연결된 소켓을 붙인다(슬롯이 모자라면 닫고 NULL)
+	void addClient(int fd);
+	Client* attachClient(int fd, in_addr info);
+	void deleteClient(int fd, TraceClose reason = CLOSE_QUIT);
+
+	// 클라이언트와 연결 확인. 마감이 지난 클라이언트만 본다
+	void handleTimers();
+
+	// ERROR를 보내고 연결 끊기
+	void closeClient(int fd, std::string const& reason, TraceClose code);
+
+	// 송신 큐 한도를 넘긴 클라이언트 끊기. 밀린 내용은 버리고 ERROR만 보낸다
+	void evictClient(int fd);
+
+	// I/O. processLines는 수신 버퍼의 줄을 처리 한도만큼 실행한다
+	void handleReadEvent(Client& client);
+	void processLines(Client& client);
+	void handleWriteEvent(Client& client);
+	void flushPendingWrites();
+
+	// 송신 큐에 남은 양과 흐름 제어에 맞춰 poller 관심을 바꾼다(남았으면 쓰기, sendqSoft를 넘었거나 멈췄으면 읽기 끄기)
+	void updateInterest(Client& client);
+
+	// 다른 스레드에서 이 reactor의 클라이언트에게 메세지 넘기기, 루프 깨우기
+	void post(ClientHandle handle, Payload* payload);
+	void wakeUp();
+
+	bool containsCurrentEvent(int ident);
+	bool isServerEvent(int ident);
+	int getId() const;
+	// 계측을 out에 더한다. 이 reactor 스레드면 도는 값을, 아니면 마지막 사본을 더한다
+	void mergeStats(Stats& out);
+
+	// 현재 스레드의 reactor, 다른 reactor 소속 fd로 메세지 넘기기(서버 상태 잠금 중에만)
+	static Reactor* getCurrent();
+	static void forward(int fd, Payload* payload);
+};
+
+#endif
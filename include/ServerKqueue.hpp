@@ -8,46 +8,53 @@
 
 # include <sys/types.h>
 # include <sys/socket.h>
-# include <sys/event.h>
-# include <sys/time.h>
 # include <arpa/inet.h>
 # include <unistd.h>
 
 class Client;
 class Channel;
+class Reactor;
 
 # include "Client.hpp"
+# include "ClientTable.hpp"
 # include "Channel.hpp"
+# include "Reactor.hpp"
+# include "./utils/Mutex.hpp"
 # include "./utils/CommandExecute.hpp"
+# include "./utils/CommandTable.hpp"
+# include "./utils/RegisterBurst.hpp"
 # include "./utils/Message.hpp"
 # include "./utils/Buffer.hpp"
+# include "./utils/Stats.hpp"
 # include "./utils/Print.hpp"
 # include "./utils/error.hpp"
 
 /*
 	server가 하는 일
 	1. client의 연결, 연결 해제, 연결 오류 처리 등. 전반적인 네트워크 연결을 담당한다.
-		a. 소켓을 보유
-		b. 클라이언트 목록 보유
+		a. 실제 이벤트 루프와 소켓은 Reactor가 보유. server는 reactor를 N개 띄운다
+		b. 클라이언트 목록 보유(모든 reactor의 클라이언트, fd로 바로 찾는 ClientTable)
 		c. IRC 서버 운영자
 	2. 채널의 생성, 해제 관리
 		a. 채널 목록 보유
 	3. 메세지 파싱
 	4. IRC 프로토콜 명령어를 연결
-		a. 명령어 핸들링 보유
+		a. 명령어 핸들링 보유(CommandTable로 이름에서 핸들러를 바로 찾는다)
 		b. 명령어 핸들링 결과 나오는 숫적 응답 및 오류 처리
 	5. 클라이언트에 주기적으로 핑 보내기
 	6. 시그널 핸들링
+		a. SIGUSR1을 받으면 모든 reactor의 계측(Stats)을 합쳐 로그로 남긴다
+		b. SIGUSR2를 받으면 기록 파일(FlightRecorder)을 덤프한다
+	7. reactor 스레드끼리 공유하는 상태(클라이언트, 채널 명단)를 stateLock으로 보호
+		a. 명령어 실행, 클라이언트 등록/삭제는 전부 stateLock 안에서 한다
+		b. recv, send, 메세지 파싱은 잠금 없이 각 reactor가 한다
 */
 
-# define CNT_EVENT_POOL 15
+# define CNT_EVENT_POOL MAX_EVENTS_PER_WAKEUP
 
 class Server {
-	typedef std::vector<struct kevent> kquvec;
 private:
 	// irc 서버로서 가져야 할 기본 정보들
-	int serverSocket;
-	struct sockaddr_in servAddr;
 	std::string password;
 	std::string opName;
 	std::string opPassword;
@@ -55,59 +62,82 @@ private:
 	int port;
 	Client* op;
 	time_t startTime;
+	std::string motd;
 
 	// 서버 종료가 필요할 때, 플래그를 올려줄 함수
-	bool running;
+	volatile bool running;
 
-	// 소켓 이용 통신 및 명령어 집행 시 필요
-	int kq;
-	kquvec eventListToRegister;
+	// 이벤트 루프를 도는 reactor 스레드들. reactors[0]은 메인 스레드에서 돈다
+	int reactorCount;
+	std::vector<Reactor*> reactors;
 
-	// client, channel 명단
-	cltmap clientList;
+	// client, channel 명단과 이를 보호하는 잠금
+	Mutex stateLock;
+	ClientTable clients;
 	chlmap channelList;
 
-	void runCommand(int fd);
+	// 별칭으로 클라이언트 찾기(rfc1459 대소문자 무시)
+	NickIndex nickIndex;
+
+	// 명령어 이름 -> 핸들러. 만든 뒤로는 읽기만 한다
+	CommandTable commands;
+
+	// 등록을 마친 클라이언트에게 보낼 환영 묶음. 시작할 때, MOTD가 바뀔 때 다시 만든다
+	RegisterBurst burst;
+
+	// STATS, 시그널 덤프가 reactor들의 계측을 합쳐 두는 곳. stateLock 아래에서 다시 쓴다
+	Stats statsTotal;
 public:
-	// 생성자와 파괴자
-	Server(std::string port, std::string password);
+	// 생성자와 파괴자. host를 주면 호스트 이름을 찾지 않고 그대로 쓴다(시험 도구)
+	Server(std::string port, std::string password, int reactorCount = 1, std::string const& host = "");
 	~Server();
 
-	// 소켓 연결 및 통신
-	void init();
+	// reactor 생성 및 각 reactor의 소켓 연결. listen이 false면 리슨 소켓 없이 reactor만 만든다
+	void init(bool listen = true);
 
 	// 소켓을 연 후에 계속 돌아가는 부분
 	void loop();
+	void stop();
+	bool isRunning() const;
 
-	// event 넣기
-	void pushEventToList(kquvec& list, uintptr_t ident, int16_t filter, uint16_t flags, uint32_t fflags, intptr_t data, void* udata);
-
-	// 클라이언트 생성 및 삭제
-	void addClient(int fd);
-	void deleteClient(int fd);
+	// 클라이언트 생성 및 삭제(reactor가 accept, close 할 때 호출). 슬롯이 모자라면 NULL
+	Client* registerClient(int fd, in_addr info, int owner);
+	void unregisterClient(int fd);
 
 	// 채널 생성 및 삭제
 	void addChannel(std::string& chName, Client* client);
 	void delChannel(std::string& chName);
 
-	// 클라이언트와 연결 확인
-	void handleDisconnectedClients();
+	// 모든 reactor의 계측을 합친다. 다른 reactor의 것은 마지막 사본이라 최대 1초 늦다
+	// 돌려준 것은 stateLock을 잡고 있는 동안만 쓴다
+	Stats const& collectStats();
+	void dumpStats();
 
-	// I/O
-	void handleReadEvent(int fd, intptr_t data);
-	void handleWriteEvent(int fd);
+	// MOTD 바꾸기. 환영 묶음도 다시 만든다
+	void setMotd(std::string const& motd);
+
+	// OPER로 운영자가 될 이름, 비밀번호. 정하지 않으면 OPER는 늘 실패한다
+	void setOperator(std::string const& name, std::string const& password);
+
+	// 명령어 실행. stateLock을 잡은 상태에서 호출
+	void runCommand(Client& client, Message const& message);
 
 	// private 변수 내용물 받기
-	int const& getServerSocket() const;
 	std::string const& getHost() const;
-	struct sockaddr_in const& getServAddr() const;
 	int const& getPort() const;
 	std::string const& getPassword() const;
+	std::string const& getOpName() const;
+	std::string const& getOpPassword() const;
 	Client& getOp() const;
 	time_t const& getStartTime() const;
-
-	bool containsCurrentEvent(uintptr_t ident);
-	bool isServerEvent(uintptr_t ident);
+	Mutex& getStateLock();
+	ClientTable& getClients();
+	chlmap& getChannelList();
+	NickIndex& getNickIndex();
+	RegisterBurst const& getBurst() const;
+	Reactor* getReactor(int id) const;
+	CommandEntry const* getCommandEntries() const;
+	size_t getCommandCount() const;
 
 	// 에러 처리
 };
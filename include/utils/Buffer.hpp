@@ -2,22 +2,51 @@
 # define _BUFFER_HPP_
 
 # include "utils.hpp"
+# include "Payload.hpp"
+# include "SendQueue.hpp"
+# include "ReplyFormat.hpp"
 
+class Client;
+
+/*
+	읽기는 클라이언트의 수신 버퍼(RecvBuffer)로 바로 받고, 쓰기는 fd 별 송신 큐(SendQueue)에 쌓는다
+	송신 큐는 reactor마다 하나씩 있고, 정적 함수는 현재 스레드에 연결(bind)된 버퍼를 쓴다.
+	현재 reactor에 없는 fd로 보내는 메세지는 Reactor::forward로 주인 reactor에게 넘긴다.
+	여러 명에게 같은 줄을 보낼 때는 broadcast로 Payload 하나를 만들어 참조만 나눠준다.
+	sendMessage(fd, message)는 쌓기만 하고, 실제 전송은 reactor가 루프 끝에 flushPending으로 fd당 한 번 한다.
+	그래도 다 못 보낸 fd만 reactor가 쓰기 관심을 켜고, 쓰기 이벤트에서 다 보내면 다시 끈다.
+	송신 큐는 접속 등급의 sendqHard를 한도로 만든다. 넘친 fd는 flushPending이 따로 알려주고, reactor가 끊는다.
+*/
 class Buffer {
 private:
-	static fdmap bufForRead;
-	static fdmap bufForSend;
+	// fd를 번호로 쓰는 송신 큐 배열. 이 reactor가 맡지 않은 fd 자리는 NULL
+	std::vector<SendQueue*> queues;
+
+	static SendQueue* findQueue(int fd);
+
+	// writev 하고 보낸 바이트, 다 못 보낸 쓰기를 센다
+	static ssize_t flushQueue(SendQueue* queue, int fd);
+
+	// 이번 루프에서 내용이 쌓인 fd. 루프 끝에 flushPending이 한 번씩 보낸다
+	std::vector<int> dirty;
+
+	// 현재 스레드가 쓰는 버퍼
+	static THREAD_LOCAL Buffer* local;
 public:
-	static int const readMessage(int fd, intptr_t data);
+	~Buffer();
+
+	static void bind(Buffer* buffer);
+	static bool isLocal(int fd);
+	static int const readMessage(Client& client);
 	static int const sendMessage(int fd);
-	static int const sendMessage(int fd, std::string message);
-	static std::string const getReadBuf(int fd);
-	static std::string const getSendBuf(int fd);
-	static void setReadBuf(std::pair<int, std::string> val);
-	static void setSendBuf(std::pair<int, std::string> val);
-	static void resetReadBuf(int fd);
-	static void resetSendBuf(int fd);
-	static void eraseReadBuf(int fd);
+	static int const sendMessage(int fd, std::string const& message);
+	static int const sendMessage(int fd, Reply const& reply);
+	static int const sendPayload(int fd, Payload* payload);
+	static void broadcast(cltvec const& members, Reply const& reply, Client const* except);
+	static void flushPending(std::vector<int>& failed, std::vector<int>& blocked, std::vector<int>& overflowed);
+	static bool hasPending(int fd);
+	static size_t getPending(int fd);
+	static void resetSendBuf(int fd, size_t limit);
 	static void eraseSendBuf(int fd);
 };
 
@@ -4,21 +4,25 @@
 # include "utils.hpp"
 # include "../Client.hpp"
 # include "../Channel.hpp"
+# include "Message.hpp"
+# include "RegisterBurst.hpp"
+# include "Stats.hpp"
 
 namespace CommandExecute {
-	int getCommand();
 	void motd(Client& client, std::string const& serverHost);
-	void pass(Client& client, std::string const& password, std::string const& serverHost);
-	void nick(Client& client, cltmap& clientList, std::string const& serverHost);
-	void user(Client& client, std::string const& serverHost, time_t const& serverStartTime);
-	void quit(Client& client, cltmap& clientList);
-	void ping(Client& client, std::string const& serverHost);
+	void pass(Message const& message, Client& client, std::string const& password, std::string const& serverHost);
+	void nick(Message const& message, Client& client, NickIndex& nickIndex, std::string const& serverHost);
+	void user(Message const& message, Client& client, RegisterBurst const& burst, std::string const& serverHost);
+	void quit(Message const& message, Client& client, cltmap& clientList);
+	void ping(Message const& message, Client& client, std::string const& serverHost);
 	void pong(Client& client, std::string const& serverHost);
-	void mode(Client& client, chlmap& channel, std::string const& serverHost);
-	void privmsg(Client& client, chlmap& chlList);
-	void notice();
+	void mode(Message const& message, Client& client, chlmap& channel, std::string const& serverHost);
+	void privmsg(Message const& message, Client& client, chlmap& chlList, NickIndex& nickIndex, std::string const& serverHost);
+	void notice(Message const& message, Client& client, chlmap& chlList, NickIndex& nickIndex, std::string const& serverHost);
 	void part(Client& client, chlmap& chlList);
-	void join(Client& client, chlmap& chlList, std::string const& serverHost);
+	void oper(Message const& message, Client& client, std::string const& opName, std::string const& opPassword, std::string const& serverHost);
+	void stats(Message const& message, Client& client, Stats const& snapshot, time_t startTime, std::string const& serverHost);
+	void join(Message const& message, Client& client, chlmap& chlList, std::string const& serverHost);
 	void kick(Client& client, cltmap& cltList, Channel* channel);
 	void topic(Client& client, Channel* channel);
 	void invite(Client& client, cltmap& cltList, Channel* channel);
@@ -0,0 +1,55 @@
+#ifndef _COMMANDTABLE_HPP_
+# define _COMMANDTABLE_HPP_
+
+# include <cstddef>
+# include "StrView.hpp"
+
+class Server;
+class Client;
+class Message;
+
+/*
+	명령어 이름을 핸들러로 바로 찾아주는 완전 해시(perfect hash) 테이블
+
+	1. 생성할 때 명령어 목록이 서로 부딪히지 않는 해시 seed를 찾아서 고정한다
+		a. 못 찾으면(이름이 겹치는 등) 예외를 던진다
+		b. 만든 뒤에는 읽기만 하므로 여러 reactor가 잠금 없이 같이 써도 된다
+	2. 찾을 때는 해시 한 번, 이름 비교 한 번으로 끝난다. 명령어가 늘어나도 비용은 같다
+	3. 대소문자는 구분하지 않는다(RFC 1459)
+*/
+
+# define COMMAND_TABLE_SIZE 128 // 2의 거듭제곱, 명령어 수보다 넉넉하게
+
+typedef void (*CommandHandler)(Server& server, Client& client, Message const& message);
+
+// 명령어 하나의 핸들러와 실행 조건
+struct CommandEntry {
+	char const* name;
+	CommandHandler handler;
+	size_t minParams; // 명령어를 뺀 인자 최소 개수. 모자라면 ERR_NEEDMOREPARAMS
+	bool needLogin; // 등록(PASS, NICK, USER)을 마쳐야 쓸 수 있는 명령어
+	unsigned int cost; // 흐름 제어에서 클라이언트 토큰을 얼마나 쓰는지. 0이면 제한 없음(PING, PONG 등)
+};
+
+// 없는 명령어(421)도 토큰을 쓴다
+# define UNKNOWN_COMMAND_COST 1
+
+class CommandTable {
+private:
+	unsigned int seed;
+	CommandEntry const* slots[COMMAND_TABLE_SIZE];
+
+	// 사용 안 함
+	CommandTable(CommandTable const& ref);
+	CommandTable& operator=(CommandTable const& ref);
+
+	static unsigned int hash(unsigned int seed, char const* name, size_t size);
+	bool build(CommandEntry const* entries, size_t count);
+public:
+	CommandTable(CommandEntry const* entries, size_t count);
+
+	// 없는 명령어면 NULL
+	CommandEntry const* find(StrView const& token) const;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef _CONNCLASS_HPP_
+# define _CONNCLASS_HPP_
+
+# include <cstddef>
+# include <string>
+# include <arpa/inet.h>
+
+/*
+	접속 등급(connection class). 접속한 주소로 등급을 정하고, 등급마다 자원 한도를 둔다
+
+	1. 송신 큐 한도
+		a. sendqSoft를 넘으면 그 클라이언트에게서 더 읽지 않는다(다 보낼 때까지 새 명령을 받지 않는다)
+		b. sendqHard를 넘기는 내용이 들어오면 "SendQ exceeded"로 끊는다
+		c. 읽지 않는 클라이언트 하나가 서버 메모리를 끝없이 늘리거나, 다른 사람에게 가는 방송을 늦추지 못하게 한다
+	2. 루프 한 바퀴에 처리하는 명령 수(lineBudget)와 바이트 수(byteBudget)
+		a. 다 쓰면 남은 줄은 수신 버퍼에 둔 채로 다음 바퀴로 미룬다(reactor의 실행 대기열)
+		b. 한 번에 명령을 수천 개 밀어 넣는 클라이언트가 루프를 독차지하지 못하게 한다
+	3. 흐름 제어(token bucket). 클라이언트마다 floodBurst개의 토큰으로 시작해서 초마다 floodRate개씩 채운다
+		a. 명령어마다 CommandEntry의 cost만큼 쓰고, 다 쓰면(0 이하) 끊지 않고 토큰이 찰 때까지 읽기를 멈춘다
+		b. floodRate가 0인 등급은 흐름 제어를 받지 않는다(trusted 등급)
+	4. 등급표는 ConnClass.cpp에 있다. 위에서부터 처음 맞는 등급을 쓰고, 마지막 등급은 모든 주소에 맞는다
+		a. 기본으로는 모든 주소(loopback도)가 마지막 등급이라 흐름 제어를 받는다
+		b. trusted 등급은 서버를 띄울 때 -x로 네트워크를 준 경우에만 쓴다. 설정 없이 빠지는 주소는 없다
+*/
+
+struct ConnClass {
+	char const* name;
+
+	// 이 등급에 맞는 주소(network & mask)
+	in_addr_t network;
+	in_addr_t mask;
+
+	// 송신 큐 한도(바이트)
+	size_t sendqSoft;
+	size_t sendqHard;
+
+	// 루프 한 바퀴에 처리할 명령 수, 바이트 수
+	size_t lineBudget;
+	size_t byteBudget;
+
+	// 흐름 제어 토큰 상한과 초당 채우는 양(0이면 제외)
+	int floodBurst;
+	int floodRate;
+
+	static ConnClass const& classify(in_addr addr);
+
+	// trusted 등급에 맞는 네트워크를 정한다("주소/비트 수"). 형식이 틀리면 false. reactor를 띄우기 전에만 부른다
+	static bool trust(std::string const& cidr);
+};
+
+#endif
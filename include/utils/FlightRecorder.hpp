@@ -0,0 +1,149 @@
+#ifndef _FLIGHTRECORDER_HPP_
+# define _FLIGHTRECORDER_HPP_
+
+# include <ctime>
+# include <cstddef>
+# include <string>
+# include <signal.h>
+# include <pthread.h>
+
+# include "./utils.hpp"
+# include "./CommandTable.hpp"
+
+/*
+	이벤트 루프의 최근 활동을 남겨두는 이진 기록(flight recorder). -T 옵션을 줬을 때만 켜진다
+
+	1. 기록 파일을 고정 크기로 만들어 mmap(MAP_SHARED) 한다. 앞쪽은 머리(TraceHeader), 뒤로 reactor마다 원형 버퍼가 하나씩
+		a. reactor 스레드는 자기 원형 버퍼에만 쓴다(잠금, 원자 연산 없음). 다 차면 가장 오래된 것부터 덮어쓴다
+		b. 기록 하나는 24바이트. 시계 한 번 읽고 칸에 쓴 뒤 head를 하나 늘린다. 시스템 콜이 없다
+		c. 파일 자체가 최근 기록이라, 서버가 죽어도 마지막 순간까지 남는다
+	2. 남기는 것 : 접속, recv 바이트, 명령어(번호, 실행 시간, 길이), writev(보낸 양, 남은 양), 끊은 이유, 타이머, 루프 한 바퀴
+	3. 덤프 : 파일 전체를 <기록 파일>.<시각>으로 복사해서 얼려둔다
+		a. SIGUSR2를 받았을 때(첫 번째 reactor가 예약한다)
+		b. 루프 한 바퀴가 slow(us)보다 오래 걸렸을 때(그 reactor가 예약한다)
+		c. TRACE_DUMP_INTERVAL초에 한 번까지만 남긴다
+		d. reactor는 TRACE_DUMP를 기록하고 예약만 한다. 파일을 열고 쓰는 건 덤프 스레드가 한다(루프를 막지 않는다)
+	4. bench/irctrace가 파일(살아 있는 것이든 덤프든)을 시간순으로 풀어서 보여주고 합계를 낸다
+	5. 꺼져 있으면 기록 함수는 스레드 지역 포인터 하나만 보고 돌아간다
+*/
+
+# define TRACE_MAGIC "IRCTRACE"
+# define TRACE_VERSION 1
+# define TRACE_RING_RECORDS 65536 // reactor마다 기록 칸 수(2의 거듭제곱)
+# define TRACE_MAX_COMMANDS 32 // 머리에 적어둘 명령어 이름 수
+# define TRACE_NAME_LEN 16
+# define TRACE_DUMP_INTERVAL 10 // 덤프 사이 최소 간격(초)
+# define TRACE_SLOW_LOOP 50000 // 덤프를 남길 느린 바퀴의 기본 기준(us). -s로 바꾼다
+# define TRACE_DUMP_POLL 100000 // 덤프 스레드가 예약을 확인하는 간격(us)
+
+enum TraceEvent {
+	TRACE_NONE = 0,
+	TRACE_ACCEPT, // value : 주소(네트워크 바이트 순서)
+	TRACE_READ, // value : recv 반환값
+	TRACE_COMMAND, // value : 실행 시간(ns), aux : 줄 길이, extra : 명령어 번호(commandCount면 없는 명령어)
+	TRACE_SEND, // value : 보낸 바이트(오류면 TRACE_FAILED), aux : 보내고 남은 바이트
+	TRACE_CLOSE, // extra : TraceClose
+	TRACE_TIMER, // extra : TraceTimer
+	TRACE_LOOP, // value : 바쁜 시간(ns), aux : 이벤트 수
+	TRACE_DUMP, // extra : 0이면 시그널, 1이면 느린 바퀴
+	TRACE_EVENTS
+};
+
+enum TraceClose {
+	CLOSE_QUIT = 0,
+	CLOSE_EOF,
+	CLOSE_ERROR, // POLLER_ERROR, recv 오류
+	CLOSE_SEND_FAILED,
+	CLOSE_REGISTER_TIMEOUT,
+	CLOSE_PING_TIMEOUT,
+	CLOSE_SENDQ,
+	CLOSE_REASONS
+};
+
+enum TraceTimer {
+	TIMER_UNTHROTTLE = 0,
+	TIMER_PING,
+	TIMER_RESCHEDULE,
+	TIMER_KINDS
+};
+
+# define TRACE_FAILED 0xFFFFFFFFU
+
+struct TraceRecord {
+	uint64_t time; // CLOCK_MONOTONIC(ns)
+	uint32_t value;
+	uint32_t aux;
+	int32_t fd;
+	uint16_t extra;
+	uint8_t type;
+	uint8_t reactor;
+};
+
+// 파일 맨 앞. 풀어보는 쪽은 이것만 보고 나머지 위치를 계산한다
+struct TraceHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t reactorCount;
+	uint32_t ringRecords;
+	uint32_t commandCount;
+	uint64_t monoStart; // 시작할 때의 CLOCK_MONOTONIC, CLOCK_REALTIME(ns). 기록 시각을 벽시계로 바꿀 때 쓴다
+	uint64_t wallStart;
+	char commands[TRACE_MAX_COMMANDS][TRACE_NAME_LEN];
+};
+
+// 원형 버퍼 하나의 머리. head는 지금까지 쓴 기록 수(칸 번호는 head % ringRecords)
+struct TraceRingHeader {
+	volatile uint64_t head;
+	uint64_t pad[7];
+};
+
+# define TRACE_HEADER_SIZE ((sizeof(TraceHeader) + 63) / 64 * 64)
+# define TRACE_RING_SIZE(records) (sizeof(TraceRingHeader) + (records) * sizeof(TraceRecord))
+
+class FlightRecorder {
+private:
+	static char* base;
+	static size_t length;
+	static std::string path;
+	static unsigned long slow;
+	static volatile time_t lastDump;
+	static volatile sig_atomic_t dumpRequested;
+
+	// 덤프 스레드. pending은 예약된 덤프의 reason + 1(0이면 없음)
+	static pthread_t thread;
+	static volatile bool running;
+	static volatile int pending;
+
+	// 현재 스레드의 reactor가 쓰는 원형 버퍼와 번호
+	static THREAD_LOCAL TraceRingHeader* ring;
+	static THREAD_LOCAL TraceRecord* records;
+	static THREAD_LOCAL int reactor;
+
+	FlightRecorder();
+
+	static void* threadMain(void* arg);
+	static void writeDump(uint16_t reason);
+public:
+	// 기록 파일을 만들고 mmap 한 뒤 덤프 스레드를 띄운다. slow는 덤프를 남길 느린 바퀴의 기준(us, 0이면 보지 않는다)
+	static void start(std::string const& path, int reactorCount, unsigned long slow, CommandEntry const* entries, size_t entryCount);
+	static void stop();
+
+	// reactor 스레드에서 한 번 부른다. 꺼져 있으면 아무것도 하지 않는다
+	static void bind(int reactorId);
+	static bool isActive();
+
+	static unsigned long now();
+	static void record(TraceEvent type, int fd, uint32_t value, uint32_t aux = 0, uint16_t extra = 0);
+
+	// 루프 한 바퀴의 끝. start는 깨어난 시각(now()). 느렸으면 덤프를 예약한다
+	static void endLoop(unsigned long start, int cntEvents);
+
+	// 덤프를 예약한다(간격 제한). 바로 돌아오고, 복사는 덤프 스레드가 한다. reason은 TRACE_DUMP의 extra
+	static void dump(uint16_t reason);
+
+	// 시그널 처리기에서 부른다(async-signal-safe)
+	static void requestDump();
+	static bool takeDumpRequest();
+};
+
+#endif
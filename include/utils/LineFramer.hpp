@@ -0,0 +1,37 @@
+#ifndef _LINEFRAMER_HPP_
+# define _LINEFRAMER_HPP_
+
+# include "StrView.hpp"
+# include "RecvBuffer.hpp"
+
+/*
+	수신 버퍼에서 IRC 메세지 한 줄씩 잘라내는 프레이머
+	1. 이전에 종결자(CR, LF)가 없다고 확인한 곳은 다시 보지 않고, 멈춘 곳부터 이어서 찾는다
+	2. 잘라낸 줄은 복사하지 않고 수신 버퍼 안을 가리키는 StrView로 돌려준다(종결자 제외)
+		a. 다음 recv 전까지만 유효하다
+	3. 512바이트(종결자 포함) 제한은 찾는 도중에 바로 검사한다
+		a. 넘으면 그 줄의 나머지는 종결자가 나올 때까지 읽는 족족 버리고, FRAME_TOOLONG을 한 번만 돌려준다
+*/
+
+# define MESSAGE_LEN 512 // 종결자를 포함한 메세지 최대 길이(RFC 1459)
+
+// next()의 반환값
+# define FRAME_NONE 0 // 아직 완성된 줄이 없음
+# define FRAME_LINE 1 // line에 한 줄
+# define FRAME_TOOLONG 2 // 제한을 넘긴 줄을 버림
+
+class LineFramer {
+private:
+	// 수신 버퍼 앞에서부터 종결자가 없다고 확인한 길이
+	size_t scanned;
+
+	// 너무 긴 줄의 나머지를 버리는 중
+	bool discarding;
+public:
+	LineFramer();
+
+	int next(RecvBuffer& buf, StrView& line);
+	void reset();
+};
+
+#endif
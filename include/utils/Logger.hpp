@@ -0,0 +1,82 @@
+#ifndef _LOGGER_HPP_
+# define _LOGGER_HPP_
+
+# include <ctime>
+# include <cstddef>
+# include <pthread.h>
+
+# include "./utils.hpp"
+
+/*
+	이벤트 루프가 쓰는 비동기 로그
+	1. reactor 스레드는 고정 크기 원형 버퍼(ring)의 칸 하나에 기록만 남기고 바로 돌아간다
+		a. 여러 reactor가 동시에 넣을 수 있도록 칸마다 순번(seq)을 두고 CAS로 자리를 잡는다(잠금 없음)
+		b. 시스템 콜, 할당, 시각 읽기가 없다. 시각은 루프가 바퀴마다 읽어둔 getCachedTime()을 쓴다
+		c. 버퍼가 가득 차면 기다리지 않고 버린 뒤 개수만 센다
+	2. 기록 스레드 하나가 LOG_FLUSH_INTERVAL마다 버퍼를 비우면서 한 번의 write()로 모아서 쓴다
+		a. 시각 문자열은 초가 바뀔 때만 다시 만든다
+		b. 버리거나 걸러낸 기록이 있었으면 그 개수를 한 줄로 남긴다
+	3. 레벨마다 초당 LOG_RATE_PER_SEC개까지만 받는다. 접속이 몰려도 로그가 루프를 잡아먹지 않게 한다
+	4. threshold보다 낮은 레벨은 버퍼에 넣지도 않는다
+	5. 단말기에 쓸 때만 색을 입힌다
+*/
+
+# define LOG_RING_SIZE 4096 // 원형 버퍼 칸 수(2의 거듭제곱)
+# define LOG_RECORD_LEN 200 // 기록 하나의 최대 길이. 넘으면 자른다
+# define LOG_RATE_PER_SEC 1000 // 레벨마다 초당 받는 기록 수 상한
+# define LOG_FLUSH_INTERVAL 20000 // 기록 스레드가 버퍼를 비우는 간격(us)
+# define LOG_BATCH_LEN 65536 // write() 한 번에 모아 쓰는 양
+
+enum LogLevel {
+	LOG_DEBUG = 0,
+	LOG_INFO,
+	LOG_WARN,
+	LOG_ERROR,
+	LOG_LEVELS
+};
+
+class Logger {
+private:
+	// 칸 하나. seq가 칸의 상태(비었음, 채워짐)를 알려준다
+	struct Record {
+		volatile unsigned long seq;
+		LogLevel level;
+		Color color;
+		time_t time;
+		size_t len;
+		char text[LOG_RECORD_LEN];
+	};
+
+	// 레벨마다 이번 초에 받은 수
+	struct Window {
+		volatile time_t second;
+		volatile int count;
+	};
+
+	static Record ring[LOG_RING_SIZE];
+	static volatile unsigned long head;
+	static unsigned long tail;
+	static volatile unsigned long dropped;
+	static volatile unsigned long suppressed;
+	static Window windows[LOG_LEVELS];
+
+	static int fd;
+	static bool color;
+	static LogLevel threshold;
+	static volatile bool running;
+	static pthread_t thread;
+
+	Logger();
+
+	static void* threadMain(void* arg);
+	static void drain();
+public:
+	// 기록 스레드 시작, 멈추면서 남은 기록 전부 쓰기
+	static void start(int fd, LogLevel threshold);
+	static void stop();
+
+	static bool isEnabled(LogLevel level);
+	static void log(LogLevel level, Color color, char const* format, ...) __attribute__((format(printf, 3, 4)));
+};
+
+#endif
@@ -2,21 +2,43 @@
 # define _MESSAGE_HPP_
 
 /*
-	메세지 파싱 전용 정적 클래스
+	메세지 한 줄을 파싱한 결과를 담는 컨텍스트
 
-	날 것 그대로의 메세지를 파싱하여 돌려준다
+	1. 호출하는 쪽(reactor)이 갖고 있다가 줄마다 parse()로 다시 채워 쓴다
+		a. 정적 상태가 없으므로 스레드마다 컨텍스트만 따로 두면 된다
+	2. 한 번 훑으면서 prefix, 명령어, 인자의 위치만 StrView로 기록한다
+		a. 복사하지도, 힙을 쓰지도 않는다
+		b. 결과는 원본 줄(수신 버퍼)이 바뀌기 전까지만 유효하다
+	3. 예전 벡터와 같은 모양으로 읽을 수 있게 [0]은 명령어, [1]부터 인자다
+		a. 범위를 벗어난 인덱스는 빈 StrView를 돌려준다
+		b. 마지막(trailing) 인자는 앞의 ':'를 뗀 채로 담긴다
 */
 
-#include "utils.hpp"
+# include "StrView.hpp"
+
+# define MAX_PARAMS 15 // 명령어 하나에 붙는 인자 최대 개수(RFC 1459)
 
 class Message {
 private:
-	Message();
-	static mesvec comMes;
+	StrView prefix;
+
+	// [0]은 명령어, [1]부터 인자
+	StrView words[MAX_PARAMS + 1];
+	size_t count;
+
+	// 원본 줄 길이(종결자 제외). 명령어별 받은 바이트를 셀 때 쓴다
+	size_t length;
 public:
-	~Message();
-	static void parsMessage(std::string& origin);
-	static mesvec const& getMessage();
+	Message();
+
+	// 명령어가 없는 줄(빈 줄, prefix만 있는 줄)이면 false
+	bool parse(StrView const& line);
+
+	size_t size() const;
+	StrView operator[](size_t i) const;
+	StrView const& getPrefix() const;
+	StrView const& getCommand() const;
+	size_t getLength() const;
 };
 
 #endif
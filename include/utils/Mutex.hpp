@@ -0,0 +1,38 @@
+#ifndef _MUTEX_HPP_
+# define _MUTEX_HPP_
+
+# include <pthread.h>
+
+/*
+	reactor 스레드끼리 공유하는 상태(클라이언트 명단, 채널 명단, 우편함)를 지키는 pthread 뮤텍스
+	recursive로 만들면 같은 스레드가 이미 잡은 상태에서 다시 잡아도 된다
+*/
+class Mutex {
+private:
+	pthread_mutex_t mutex;
+
+	// 사용 안 함
+	Mutex(Mutex const& ref);
+	Mutex& operator=(Mutex const& ref);
+public:
+	explicit Mutex(bool recursive = false);
+	~Mutex();
+
+	void lock();
+	void unlock();
+};
+
+// 블록을 벗어나면 자동으로 unlock
+class ScopedLock {
+private:
+	Mutex& mutex;
+
+	// 사용 안 함
+	ScopedLock(ScopedLock const& ref);
+	ScopedLock& operator=(ScopedLock const& ref);
+public:
+	explicit ScopedLock(Mutex& mutex);
+	~ScopedLock();
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _NAMESCACHE_HPP_
+# define _NAMESCACHE_HPP_
+
+# include <string>
+# include <vector>
+# include <set>
+# include <map>
+
+# include "utils.hpp"
+
+/*
+	채널의 NAMES 응답(353)에 들어갈 별칭 목록을 미리 512바이트 안쪽 조각으로 나눠 들고 있는 캐시
+
+	1. 조각마다 "@op nick1 nick2 ..." 문자열을 하나씩 가진다. 조각 하나가 353 한 줄이 된다
+		a. 조각 길이는 budget을 넘지 않는다(353의 앞부분과 CRLF를 뺀 나머지)
+	2. 가입, 탈퇴, 별칭 변경, 운영자 변경은 그 가입자가 들어 있는 조각 하나만 고친다
+		a. 큰 채널에 한 명이 들어와도 목록 전체를 다시 만들지 않는다
+		b. 가입자 -> 조각 번호를 기억해두고, 조각 안에서는 단어 하나를 찾아 고친다(조각 크기 이하)
+	3. 가입자는 자리가 남은 조각 중 번호가 가장 작은 곳에 넣는다. 자리가 없으면 조각을 새로 만든다
+		a. 탈퇴로 빈 조각이 뒤에 남으면 버린다. 중간에 빈 조각은 가져갈 때 건너뛴다
+	4. 순서는 보장하지 않는다(RFC도 정하지 않는다)
+*/
+
+class NamesCache {
+private:
+	size_t budget;
+	std::vector<std::string> chunks;
+
+	// 가장 긴 단어가 하나 더 들어갈 자리가 남은 조각 번호
+	std::set<size_t> open;
+
+	// 가입자 핸들 -> 들어 있는 조각 번호
+	std::map<ClientHandle, size_t> chunkOf;
+
+	void refreshOpen(size_t chunk);
+	void trim();
+public:
+	NamesCache(size_t budget);
+
+	void add(ClientHandle handle, std::string const& name);
+	void remove(ClientHandle handle, std::string const& name);
+	void rename(ClientHandle handle, std::string const& oldName, std::string const& newName);
+
+	// 빈 조각이 섞여 있을 수 있다
+	std::vector<std::string> const& getChunks() const;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef _NICKINDEX_HPP_
+# define _NICKINDEX_HPP_
+
+# include <string>
+# include <vector>
+
+class Client;
+
+/*
+	별칭 -> Client* 해시 색인
+
+	1. 키는 rfc1459 규칙으로 대소문자를 접은(foldNick) 별칭이다
+		a. RPL_ISUPPORT에 CASEMAPPING=rfc1459를 알리므로 "Nick", "NICK", "nick[]"과 "nick{}"은 같은 별칭이다
+	2. 열린 주소법(선형 탐사) 해시 테이블. 찾기, 넣기, 빼기가 평균 O(1)
+		a. 지운 칸은 표시만 해두고, 다시 키울 때 정리한다
+	3. Client::setNick과 Client 파괴자가 관리하고, 별칭으로 대상을 찾는 명령어는 전부 이걸 쓴다
+	4. 서버 상태 잠금(stateLock) 안에서만 쓴다
+*/
+
+class NickIndex {
+private:
+	enum SlotState {
+		EMPTY = 0,
+		USED,
+		DELETED
+	};
+
+	struct Slot {
+		int state;
+		std::string key;
+		Client* client;
+	};
+
+	std::vector<Slot> slots;
+	size_t used; // USED 칸 개수
+	size_t filled; // USED + DELETED 칸 개수. 탐사 길이를 정한다
+
+	// 사용 안 함
+	NickIndex(NickIndex const& ref);
+	NickIndex& operator=(NickIndex const& ref);
+
+	static size_t hash(std::string const& key);
+	size_t probe(std::string const& key) const;
+	void rehash(size_t capacity);
+public:
+	NickIndex();
+
+	// 없으면 NULL
+	Client* find(std::string const& nick) const;
+
+	// 같은 별칭이 이미 있으면 덮어쓴다
+	void insert(std::string const& nick, Client* client);
+
+	// 그 별칭이 client를 가리킬 때만 뺀다
+	void erase(std::string const& nick, Client const* client);
+
+	size_t size() const;
+};
+
+#endif
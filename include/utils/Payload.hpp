@@ -0,0 +1,42 @@
+#ifndef _PAYLOAD_HPP_
+# define _PAYLOAD_HPP_
+
+# include <cstddef>
+# include <string>
+
+/*
+	한 번 만들면 바뀌지 않는, 참조 카운트로 공유하는 메세지 한 덩어리
+	1. 채널에 뿌리는 줄을 한 번만 만들고, 수신자마다 복사하는 대신 참조만 늘려서 송신 큐에 넣는다
+	2. 헤더와 내용을 한 번에 할당한다
+	3. 다른 reactor의 우편함으로도 넘어가므로 참조 카운트는 원자적으로 바꾼다
+	4. 만든 쪽이 참조 하나를 갖고 시작한다. 다 쓰면 release()하고, 마지막 release()가 메모리를 푼다
+*/
+
+class Payload {
+private:
+	volatile int refs;
+	size_t size;
+
+	Payload(size_t size);
+	~Payload();
+
+	// 사용 안 함
+	Payload(Payload const& ref);
+	Payload& operator=(Payload const& ref);
+public:
+	static Payload* create(char const* data, size_t size);
+	static Payload* create(std::string const& message);
+
+	// 내용을 채우지 않고 size만큼 할당만 한다. getWritable()로 채운 뒤에 공유한다
+	static Payload* allocate(size_t size);
+
+	void retain();
+	void release();
+
+	// 내용은 객체 바로 뒤에 붙어 있다
+	char const* getData() const;
+	char* getWritable();
+	size_t getSize() const;
+};
+
+#endif
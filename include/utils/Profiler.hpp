@@ -0,0 +1,110 @@
+#ifndef _PROFILER_HPP_
+# define _PROFILER_HPP_
+
+# include <ctime>
+# include <cstddef>
+
+# include "utils.hpp"
+
+/*
+	이벤트 루프 구간별 시간 측정(make PROFILE=1 일 때만)
+
+	1. reactor마다 Profiler를 하나씩 갖고, 그 reactor 스레드만 쓴다
+	2. 루프 한 바퀴를 구간(phase)으로 나눠서, 구간이 바뀔 때마다 시계를 읽고 지난 구간에 더한다
+		a. 구간은 함수 맨 앞의 PROFILE_SCOPE로 들어가고, 함수가 끝나면 들어오기 전 구간으로 돌아간다
+		b. 안쪽 구간의 시간은 바깥 구간에 들어가지 않는다(read 안의 parse, dispatch는 따로 센다)
+	3. 한 바퀴마다 이벤트 수, 바쁜 시간(wait를 뺀 나머지)의 최댓값을 적는다
+	4. PROFILE_INTERVAL초마다 기다린 비율과, 바쁜 시간 중 구간별 비율을 로그로 남기고 새로 센다
+	5. PROFILE이 정의되지 않으면 매크로는 비어 있고, reactor에 Profiler도 없다(DEBUG와 같은 방식)
+*/
+
+# define PROFILE_INTERVAL 10 // 보고 간격(초)
+
+enum ProfilePhase {
+	PHASE_LOOP = 0, // 어느 구간에도 들지 않은 루프 자체
+	PHASE_WAIT,
+	PHASE_ACCEPT,
+	PHASE_MAILBOX,
+	PHASE_READ,
+	PHASE_FRAME,
+	PHASE_PARSE,
+	PHASE_DISPATCH,
+	PHASE_WRITE,
+	PHASE_TIMERS,
+	PHASE_FLUSH,
+	PHASE_CLOSE,
+	PHASE_COUNT
+};
+
+class Profiler {
+private:
+	int id;
+
+	// 구간별 누적 시간(ns), 지금 구간과 그 구간에 들어온 시각
+	unsigned long phaseTime[PHASE_COUNT];
+	ProfilePhase phase;
+	unsigned long mark;
+
+	// 바퀴 수, 이벤트 수, 바쁜 시간(ns). 바퀴 시작 시각
+	unsigned long iterations;
+	unsigned long events;
+	unsigned long maxEvents;
+	unsigned long busyTotal;
+	unsigned long maxBusy;
+	unsigned long iterationStart;
+
+	// 마지막으로 보고한 시각
+	time_t reportStamp;
+
+	static THREAD_LOCAL Profiler* local;
+
+	static unsigned long now();
+	void reset();
+
+	// 사용 안 함
+	Profiler(Profiler const& ref);
+	Profiler& operator=(Profiler const& ref);
+public:
+	explicit Profiler(int id);
+
+	static void bind(Profiler* profiler);
+	static Profiler* getLocal();
+
+	// 지금까지를 지금 구간에 더하고 next로 바꾼다. 들어오기 전 구간을 돌려준다
+	ProfilePhase enter(ProfilePhase next);
+
+	// poller에서 기다리기 직전(바퀴 끝), 깨어난 직후(바퀴 시작)
+	void beginWait();
+	void endWait(int cntEvents);
+
+	// 보고 간격이 지났으면 로그로 남기고 새로 센다
+	void report(time_t now);
+};
+
+// 함수가 끝날 때 들어오기 전 구간으로 돌아간다
+class ProfileScope {
+private:
+	Profiler* profiler;
+	ProfilePhase previous;
+
+	// 사용 안 함
+	ProfileScope(ProfileScope const& ref);
+	ProfileScope& operator=(ProfileScope const& ref);
+public:
+	explicit ProfileScope(ProfilePhase phase);
+	~ProfileScope();
+};
+
+# ifdef PROFILE
+#  define PROFILE_SCOPE(phase) ProfileScope profileScope(phase)
+#  define PROFILE_BEGIN_WAIT() Profiler::getLocal()->beginWait()
+#  define PROFILE_END_WAIT(cntEvents) Profiler::getLocal()->endWait(cntEvents)
+#  define PROFILE_REPORT(now) Profiler::getLocal()->report(now)
+# else
+#  define PROFILE_SCOPE(phase)
+#  define PROFILE_BEGIN_WAIT()
+#  define PROFILE_END_WAIT(cntEvents)
+#  define PROFILE_REPORT(now)
+# endif
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef _RECVBUFFER_HPP_
+# define _RECVBUFFER_HPP_
+
+# include <cstddef>
+# include <sys/types.h>
+
+/*
+	클라이언트 하나가 가지는 고정 크기 수신 버퍼
+	1. recv()가 이 버퍼에 바로 쓴다. 읽을 때마다 힙 할당이나 fd 맵 조회가 없다
+	2. [head, tail) 구간이 아직 처리하지 않은 내용이고, 완성된 줄은 버퍼 안에서 그대로 읽고 consume 한다
+	3. tail이 끝에 닿으면 남은 내용(완성되지 않은 한 줄)을 앞으로 당긴다
+		a. 줄이 버퍼 중간에서 끊기지 않으므로, 한 줄은 항상 연속된 메모리에 있다
+*/
+
+# define RECV_BUFFER_SIZE 4096 // 클라이언트 당 수신 버퍼 크기
+
+class RecvBuffer {
+private:
+	char data[RECV_BUFFER_SIZE];
+	size_t head;
+	size_t tail;
+
+	// 사용 안 함
+	RecvBuffer(RecvBuffer const& ref);
+	RecvBuffer& operator=(RecvBuffer const& ref);
+public:
+	RecvBuffer();
+
+	// 남은 공간에 바로 recv. recv의 반환값을 그대로 돌려준다(남은 공간이 없으면 읽지 않고 SYS_FAILURE, EAGAIN)
+	ssize_t readFrom(int fd);
+
+	// 처리하지 않은 내용의 시작과 길이
+	char const* begin() const;
+	size_t size() const;
+
+	// 앞에서부터 n 바이트 처리 완료
+	void consume(size_t n);
+	void clear();
+};
+
+#endif
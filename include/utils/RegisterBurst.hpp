@@ -0,0 +1,49 @@
+#ifndef _REGISTERBURST_HPP_
+# define _REGISTERBURST_HPP_
+
+# include <ctime>
+# include <string>
+# include <vector>
+
+# include "ReplyFormat.hpp"
+
+/*
+	등록을 마친 클라이언트에게 보내는 환영 묶음(001~005, MOTD)을 미리 만들어 두는 틀
+
+	1. 서버를 켤 때(그리고 MOTD나 설정이 바뀔 때) reply:: 함수로 묶음 전체를 한 번 만든다
+		a. 클라이언트마다 달라지는 자리(별칭, 사용자 이름, 호스트)에는 표시 문자를 넣어두고 그 자리에서 자른다
+		b. MOTD도 표시 문자로 넣어두고 자를 때 고정 조각에 값으로 붙인다. MOTD 안의 \x01(CTCP)을 표시로 읽지 않는다
+		c. 서버 시작 시간 문자열 같은 나머지는 전부 고정 조각으로 남는다
+	2. 등록이 끝날 때마다 render()가 고정 조각 사이에 클라이언트 값만 끼워 Payload 하나에 바로 쓴다
+		a. 8줄을 따로 만들고 따로 큐에 넣는 대신 할당 한 번, 송신 큐 항목 하나, write 한 번
+	3. build()와 render()는 서버 상태 잠금 안에서만 부른다
+*/
+
+class RegisterBurst {
+private:
+	// 고정 조각 뒤에 끼울 클라이언트 값
+	enum Field {
+		FIELD_NONE,
+		FIELD_NICK,
+		FIELD_USER,
+		FIELD_HOST
+	};
+
+	struct Segment {
+		std::string text;
+		Field field;
+	};
+
+	std::vector<Segment> segments;
+
+	// 사용 안 함
+	RegisterBurst(RegisterBurst const& ref);
+	RegisterBurst& operator=(RegisterBurst const& ref);
+public:
+	RegisterBurst();
+
+	void build(std::string const& serverHost, time_t const& startTime, std::string const& motd);
+	Reply render(std::string const& nick, std::string const& user, std::string const& host) const;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef _REPLYFORMAT_HPP_
+# define _REPLYFORMAT_HPP_
+
+# include <cstddef>
+# include <string>
+
+# include "StrView.hpp"
+# include "Payload.hpp"
+
+/*
+	응답 한 줄을 송신 큐에 들어갈 Payload에 바로 써넣는 포매터
+
+	1. ReplyFormat은 조각(고정 문자열, 서버 이름, 별칭 ...)을 복사하지 않고 위치와 길이만 모은다
+		a. 문자열 리터럴은 배열 크기로 길이를 알아내므로 strlen도 하지 않는다
+	2. done()에서 전체 길이를 알고 있으므로 Payload를 딱 한 번, 딱 맞게 할당하고 조각마다 한 번씩만 복사한다
+		a. operator+ 사슬처럼 중간 임시 문자열이 생기지 않는다
+		b. 만든 Payload는 그대로 송신 큐에 참조로 들어가므로 송신 버퍼로 다시 복사하지 않는다
+	3. Reply는 Payload 참조 하나를 쥐고 있는 핸들. 복사하면 참조가 늘고, 사라지면 놓는다
+
+	쓰는 법 : return (ReplyFormat() << ":" << serverHost << " 001 " << nick << CRLF).done();
+	조각은 한 줄에 REPLY_MAX_PIECES개까지. 넘기면 예외(코드를 고쳐야 하는 상황)
+*/
+
+# define REPLY_MAX_PIECES 32
+
+class Reply {
+private:
+	Payload* payload;
+public:
+	Reply();
+	// 참조 하나를 넘겨받는다
+	explicit Reply(Payload* payload);
+	Reply(Reply const& ref);
+	Reply& operator=(Reply const& ref);
+	~Reply();
+
+	Payload* get() const;
+	size_t size() const;
+	std::string str() const;
+};
+
+class ReplyFormat {
+private:
+	StrView pieces[REPLY_MAX_PIECES];
+
+	// 문자 하나짜리 조각(모드 문자 등)이 가리킬 자리
+	char chars[REPLY_MAX_PIECES];
+	size_t count;
+	size_t length;
+
+	// 사용 안 함
+	ReplyFormat(ReplyFormat const& ref);
+	ReplyFormat& operator=(ReplyFormat const& ref);
+
+	void append(char const* data, size_t size);
+public:
+	ReplyFormat();
+
+	template <size_t N>
+	ReplyFormat& operator<<(char const (&literal)[N]) {
+		this->append(literal, N - 1);
+		return *this;
+	}
+	ReplyFormat& operator<<(std::string const& str);
+	ReplyFormat& operator<<(StrView const& str);
+	ReplyFormat& operator<<(char c);
+
+	Reply done() const;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef _SENDQUEUE_HPP_
+# define _SENDQUEUE_HPP_
+
+# include <deque>
+# include <sys/types.h>
+
+# include "Payload.hpp"
+
+/*
+	클라이언트 하나의 송신 큐
+	1. 보낼 내용을 복사하지 않고 Payload 참조로 쌓는다
+	2. flush는 쌓인 조각을 iovec으로 묶어 writev 한 번으로 보낸다
+	3. 맨 앞 조각을 얼마나 보냈는지(offset) 기억했다가, 다 보낸 조각부터 참조를 놓는다
+	4. 한도(limit)를 넘기는 조각은 넣지 않고 넘침(overflowed) 표시만 한다. 표시가 서면 이후 조각도 전부 버린다
+		a. 넘친 클라이언트는 reactor가 루프 끝에 끊는다
+*/
+
+# define SENDQUEUE_IOV_MAX 64 // writev 한 번에 넘기는 조각 수
+
+class SendQueue {
+private:
+	std::deque<Payload*> chunks;
+
+	// 맨 앞 조각에서 이미 보낸 바이트 수
+	size_t offset;
+
+	// 아직 보내지 않은 총 바이트 수
+	size_t pending;
+
+	// 이번 루프가 끝날 때 보낼 목록에 올라가 있는지
+	bool scheduled;
+
+	// 쌓아둘 수 있는 최대 바이트 수(0이면 제한 없음)와 그걸 넘긴 적이 있는지
+	size_t limit;
+	bool overflowed;
+
+	// 사용 안 함
+	SendQueue(SendQueue const& ref);
+	SendQueue& operator=(SendQueue const& ref);
+
+	void consume(size_t n);
+public:
+	SendQueue();
+	~SendQueue();
+
+	// 참조를 하나 늘려서 뒤에 붙인다. 한도를 넘기면 붙이지 않고 false
+	bool push(Payload* payload);
+
+	// 보낸 바이트 수. 소켓이 가득 차서 못 보냈으면 0, 오류면 SYS_FAILURE
+	ssize_t flush(int fd);
+
+	bool empty() const;
+	size_t size() const;
+	void clear();
+
+	bool isScheduled() const;
+	void setScheduled(bool flag);
+
+	void setLimit(size_t limit);
+	bool isOverflowed() const;
+};
+
+#endif
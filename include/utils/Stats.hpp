@@ -0,0 +1,132 @@
+#ifndef _STATS_HPP_
+# define _STATS_HPP_
+
+# include <ctime>
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <signal.h>
+
+# include "utils.hpp"
+# include "CommandTable.hpp"
+
+/*
+	항상 켜 두는 가벼운 계측
+
+	1. reactor마다 Stats를 하나씩 갖고, 그 reactor 스레드만 쓴다(잠금, 원자 연산 없음)
+		a. 스레드에 연결(bind)해 두고 Buffer, 명령어 실행 쪽은 정적 함수로 센다. 연결 안 된 스레드(벤치마크 등)에서는 아무것도 안 한다
+		b. 다른 스레드는 도는 중인 값을 읽지 않는다. reactor가 1초에 한 번 자기 루프에서 사본을 떠서(publish) 잠금 아래 내놓는다
+		c. 보는 쪽(STATS, 시그널 덤프)은 자기 reactor의 것은 그대로, 나머지는 내놓은 사본을 합친다(최대 1초 늦다)
+	2. 명령어마다 호출 수, 받은 바이트 수, 실행 시간 히스토그램(ns)
+		a. 시간은 runCommand 앞뒤로 CLOCK_MONOTONIC을 두 번 읽는다(vDSO라 시스템 콜이 아니다)
+		b. 히스토그램은 2의 거듭제곱 구간마다 8칸(오차 약 12%). 기록은 비트 연산 몇 번이다
+	3. 이벤트 종류별 수, 받은/보낸 바이트, recv, writev 호출 수, 다 못 보낸 쓰기, 끊은 수, 흐름 제어 수
+	4. 송신, 수신 큐 깊이는 1초에 한 번만 클라이언트를 훑어서 적어둔다
+	5. 운영자(OPER)는 STATS m(명령어), STATS e(이벤트, I/O, 큐)로 보고, SIGUSR1을 받으면 둘 다 로그로 남긴다
+*/
+
+# define STATS_HIST_SUB_BITS 3
+# define STATS_HIST_SUB (1 << STATS_HIST_SUB_BITS)
+# define STATS_HIST_BUCKETS (48 * STATS_HIST_SUB) // 2^48 ns(약 3일)까지
+# define STATS_PUBLISH_WAIT 1000 // 사본을 뜬 뒤로 일이 있었으면 이보다 오래 기다리지 않는다(ms)
+
+enum StatsCounter {
+	STAT_EV_ACCEPT = 0,
+	STAT_EV_READ,
+	STAT_EV_WRITE,
+	STAT_EV_ERROR,
+	STAT_EV_WAKE,
+	STAT_EV_TIMER,
+	STAT_LOOPS,
+	STAT_BYTES_IN,
+	STAT_BYTES_OUT,
+	STAT_LINES_IN,
+	STAT_RECV_CALLS,
+	STAT_WRITE_CALLS,
+	STAT_PARTIAL_WRITES,
+	STAT_SENDQ_EVICTIONS,
+	STAT_FLOOD_THROTTLES,
+	STAT_COUNTERS
+};
+
+// 값(ns)의 분포. 합치기 쉽도록 고정 크기 배열
+struct LatencyHistogram {
+	unsigned long counts[STATS_HIST_BUCKETS];
+	unsigned long total;
+	unsigned long sum;
+	unsigned long max;
+
+	LatencyHistogram();
+
+	void record(unsigned long value);
+	void merge(LatencyHistogram const& other);
+
+	// p(0 ~ 1) 지점 값이 들어 있는 칸의 윗 경계
+	unsigned long percentile(double p) const;
+};
+
+struct CommandStats {
+	unsigned long calls;
+	unsigned long bytes;
+	LatencyHistogram latency;
+
+	CommandStats();
+};
+
+class Stats {
+private:
+	// 명령어 테이블 순서대로, 마지막 칸은 없는 명령어
+	CommandEntry const* entries;
+	size_t entryCount;
+	std::vector<CommandStats> commands;
+
+	unsigned long counters[STAT_COUNTERS];
+
+	// 큐 깊이(바이트). 마지막으로 훑은 시각
+	size_t clientCount;
+	size_t sendqTotal;
+	size_t sendqMax;
+	size_t recvqTotal;
+	size_t recvqMax;
+	time_t depthStamp;
+
+	// 현재 스레드의 reactor가 쓰는 Stats
+	static THREAD_LOCAL Stats* local;
+
+	// 시그널 처리기가 올리고, 첫 번째 reactor가 내린다
+	static volatile sig_atomic_t dumpRequested;
+public:
+	Stats(CommandEntry const* entries, size_t entryCount);
+
+	static void bind(Stats* stats);
+	static Stats* getLocal();
+
+	// 단조 시계(ns)
+	static unsigned long now();
+
+	// 현재 스레드의 Stats에 센다
+	static void count(StatsCounter counter, unsigned long n = 1);
+	static void recordCommand(CommandEntry const* entry, size_t bytes, unsigned long elapsed);
+
+	// 큐 깊이. 이번 초에 이미 적었으면 isDepthStale이 false
+	bool isDepthStale(time_t now) const;
+	void setDepth(time_t now, size_t clients, size_t sendqTotal, size_t sendqMax, size_t recvqTotal, size_t recvqMax);
+
+	// 다른 reactor의 것을 더한다(깊이는 합과 최대). reset은 합치기 전에 0으로(할당 없음)
+	void merge(Stats const& other);
+	void reset();
+
+	// 사람이 읽는 줄로 풀어낸다. m은 명령어, e는 이벤트와 I/O, 큐
+	void describe(char query, std::vector<std::string>& lines) const;
+
+	size_t getEntryCount() const;
+	CommandEntry const& getEntry(size_t index) const;
+	CommandStats const& getCommand(size_t index) const;
+	unsigned long getCounter(StatsCounter counter) const;
+
+	// 시그널 처리기에서 부른다(async-signal-safe)
+	static void requestDump();
+	static bool takeDumpRequest();
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _STRVIEW_HPP_
+# define _STRVIEW_HPP_
+
+# include <cstddef>
+# include <string>
+
+/*
+	다른 버퍼 안의 문자열을 가리키기만 하는 (포인터, 길이) 쌍
+	복사하지 않으므로, 가리키는 버퍼가 바뀌기 전까지만 유효하다
+	std::string이 필요한 곳(저장, 응답 만들기)에서는 암묵적으로 변환된다
+*/
+struct StrView {
+	char const* data;
+	size_t size;
+
+	StrView();
+	StrView(char const* data, size_t size);
+
+	// 범위를 벗어나면 0
+	char operator[](size_t i) const;
+	bool empty() const;
+	std::string str() const;
+	operator std::string() const;
+};
+
+bool operator==(StrView const& lhs, char const* rhs);
+bool operator==(StrView const& lhs, std::string const& rhs);
+bool operator!=(StrView const& lhs, char const* rhs);
+bool operator!=(StrView const& lhs, std::string const& rhs);
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef _TIMERWHEEL_HPP_
+# define _TIMERWHEEL_HPP_
+
+# include <ctime>
+# include <vector>
+
+/*
+	클라이언트별 마감 시각(등록 시간 초과, 일정 시간 조용하면 PING, PONG 시간 초과)을 관리하는 계층형 타이머 휠
+
+	1. 눈금 하나는 1초. 64칸짜리 휠 3단(64초, 약 68분, 약 72시간)
+		a. 마감이 가까운 타이머는 아래 단, 먼 타이머는 위 단에 넣는다
+		b. 아래 단이 한 바퀴 돌 때마다 위 단의 한 칸을 풀어서 아래 단으로 다시 나눠 넣는다
+		c. 72시간보다 먼 마감은 맨 위 단의 가장 먼 칸에 넣었다가 내려올 때 다시 나눈다
+	2. 타이머 노드는 주인(Client) 안에 들어 있는 이중 연결 리스트 노드라서 넣고 빼는 데 할당이 없다
+	3. advance()는 지난 눈금만 처리하므로 비용은 만료된 타이머 수에 비례한다(전체 클라이언트 수가 아님)
+	4. 이벤트 루프의 poller 대기 시간을 nextTimeout()으로 정한다
+	5. reactor 하나가 자기 클라이언트에 대해서만 쓴다. 잠금 없음
+*/
+
+# define WHEEL_BITS 6
+# define WHEEL_SIZE (1 << WHEEL_BITS)
+# define WHEEL_LEVELS 3
+
+struct TimerNode {
+	TimerNode* prev;
+	TimerNode* next;
+	time_t expire;
+	void* owner;
+
+	TimerNode();
+	bool isLinked() const;
+};
+
+class TimerWheel {
+private:
+	// 칸마다 빈 머리 노드를 두고 원형으로 잇는다
+	TimerNode slots[WHEEL_LEVELS][WHEEL_SIZE];
+
+	// 마지막으로 처리한 눈금
+	time_t current;
+	size_t count;
+
+	// 사용 안 함
+	TimerWheel(TimerWheel const& ref);
+	TimerWheel& operator=(TimerWheel const& ref);
+
+	// earliest보다 이른 마감은 earliest 눈금에 넣는다
+	void place(TimerNode* node, time_t earliest);
+	void cascade(int level, size_t index);
+	static void unlink(TimerNode* node);
+public:
+	TimerWheel();
+
+	// 시계를 맞춘다. 첫 advance() 전에 한 번 부른다
+	void start(time_t now);
+
+	// 이미 걸려 있으면 옮긴다
+	void schedule(TimerNode* node, time_t expire);
+	void cancel(TimerNode* node);
+
+	// now까지의 눈금을 처리하고, 만료된 노드를 빼서 expired에 담는다
+	void advance(time_t now, std::vector<TimerNode*>& expired);
+
+	// 다음 만료까지 poller가 기다릴 시간(ms). 타이머가 없으면 -1
+	int nextTimeout(time_t now) const;
+
+	size_t size() const;
+};
+
+#endif
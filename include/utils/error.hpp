@@ -2,28 +2,40 @@
 # define _ERROR_HPP_
 
 # include <string>
+# include "utils.hpp"
+# include "ReplyFormat.hpp"
 
 // 숫적 응답(numeric reply) 중, 에러 담당
+// 문자열을 이어 붙이지 않고 ReplyFormat으로 송신 큐에 들어갈 Payload에 바로 쓴다
 namespace error {
-	std::string const ERR_INPUTTOOLONG(std::string const& serverHost);
-	std::string const ERR_NEEDMOREPARAMS(std::string const& serverHost, std::string const& command);
-	std::string const ERR_ALREADYREGISTERED(std::string const& serverHost);
-	std::string const ERR_PASSWDMISMATCH(std::string const& serverHost);
-	std::string const ERR_NONICKNAMEGIVEN(std::string const& serverHost);
-	std::string const ERR_NICKNAMEINUSE(std::string const& serverHost, std::string const& nick);
-	std::string const ERR_ERRONEUSNICKNAME(std::string const& serverHost, std::string const& nick);
-	std::string const ERR_NOTREGISTERED(std::string const& serverHost, std::string const& reason);
-	std::string const ERR_UNKNOWNCOMMAND(std::string const& serverHost, std::string const& command);
-	std::string const ERR_NOORIGIN(std::string const& serverHost, std::string const& nick);
-	std::string const ERR_INVALIDMODEPARAM(std::string const& serverHost, std::string const& nick, std::string const& chName, char const& mode, std::string const& reason);
-	std::string const ERR_UNKNOWNMODE(std::string const& serverHost, std::string const& nick, char const& mode);
-	std::string const ERR_NOSUCHCHANNEL(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const ERR_CHANOPRIVSNEEDED(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const ERR_BADCHANMASK(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const ERR_TOOMANYCHANNELS(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const ERR_CHANNELISFULL(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const ERR_INVITEONLYCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const ERR_BADCHANNELKEY(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_INPUTTOOLONG(std::string const& serverHost);
+	Reply const ERR_NEEDMOREPARAMS(std::string const& serverHost, std::string const& command);
+	Reply const ERR_ALREADYREGISTERED(std::string const& serverHost);
+	Reply const ERR_PASSWDMISMATCH(std::string const& serverHost);
+	Reply const ERR_NONICKNAMEGIVEN(std::string const& serverHost);
+	Reply const ERR_NICKNAMEINUSE(std::string const& serverHost, std::string const& nick);
+	Reply const ERR_ERRONEUSNICKNAME(std::string const& serverHost, std::string const& nick);
+	Reply const ERR_NOTREGISTERED(std::string const& serverHost, std::string const& reason);
+	Reply const ERR_UNKNOWNCOMMAND(std::string const& serverHost, std::string const& command);
+	Reply const ERR_NOORIGIN(std::string const& serverHost, std::string const& nick);
+	Reply const ERR_INVALIDMODEPARAM(std::string const& serverHost, std::string const& nick, std::string const& chName, char const& mode, std::string const& reason);
+	Reply const ERR_UNKNOWNMODE(std::string const& serverHost, std::string const& nick, char const& mode);
+	Reply const ERR_NOSUCHCHANNEL(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_CHANOPRIVSNEEDED(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_BADCHANMASK(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_TOOMANYCHANNELS(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_CHANNELISFULL(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_INVITEONLYCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_BADCHANNELKEY(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_NOSUCHNICK(std::string const& serverHost, std::string const& nick, std::string const& target);
+	Reply const ERR_CANNOTSENDTOCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const ERR_NORECIPIENT(std::string const& serverHost, std::string const& nick, std::string const& command);
+	Reply const ERR_NOTEXTTOSEND(std::string const& serverHost, std::string const& nick);
+	Reply const ERR_NOPRIVILEGES(std::string const& serverHost, std::string const& nick);
+	Reply const ERR_NOOPERHOST(std::string const& serverHost, std::string const& nick);
+
+	// 숫자는 아니지만 연결을 끊기 전에 보내는 ERROR 메세지
+	Reply const ERROR_CLOSINGLINK(std::string const& host, std::string const& reason);
 }
 
 #endif
@@ -2,25 +2,36 @@
 # define _REPLY_HPP_
 
 # include <string>
+# include "utils.hpp"
+# include "ReplyFormat.hpp"
 
 // 숫적 응답(numeric reply) 중, 정상 응답 담당
+// 문자열을 이어 붙이지 않고 ReplyFormat으로 송신 큐에 들어갈 Payload에 바로 쓴다
 namespace reply {
-	std::string const RPL_WELCOME(std::string const& serverHost, std::string const& nick, std::string const& user, std::string const& host);
-	std::string const RPL_YOURHOST(std::string const& serverHost, std::string const& nick, std::string const& version);
-	std::string const RPL_CREATED(std::string const& serverHost, std::string const& nick, std::string const& date);
-	std::string const RPL_MYINFO(std::string const& serverHost, std::string const& nick, std::string const& version, std::string const& usermode, std::string const& chanmode);
-	std::string const RPL_ISUPPORT(std::string const& serverHost, std::string const& nick);
-	std::string const RPL_MOTDSTART(std::string const& serverHost, std::string const& nick);
-	std::string const RPL_MOTD(std::string const& serverHost, std::string const& nick, std::string const& line);
-	std::string const RPL_ENDOFMOTD(std::string const& serverHost, std::string const& nick);
-	std::string const RPL_SUCCESSMODE(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName, std::string const& mode, std::string const& argument);
-	std::string const RPL_CHANNELMODEIS(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& mode, std::string const& argument);
-	std::string const RPL_CREATIONTIME(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& time);
-	std::string const RPL_SUCCESSJOIN(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName);
-	std::string const RPL_TOPIC(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& topic);
-	std::string const RPL_NAMREPLY(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& userList);
-	std::string const RPL_ENDOFNAMES(std::string const& serverHost, std::string const& nick, std::string const& chName);
-	std::string const RPL_SUCCESSQUIT(std::string const& nick, std::string const& user, std::string const& host, std::string const& reason);
+	Reply const RPL_WELCOME(std::string const& serverHost, std::string const& nick, std::string const& user, std::string const& host);
+	Reply const RPL_YOURHOST(std::string const& serverHost, std::string const& nick, std::string const& version);
+	Reply const RPL_CREATED(std::string const& serverHost, std::string const& nick, std::string const& date);
+	Reply const RPL_MYINFO(std::string const& serverHost, std::string const& nick, std::string const& version, std::string const& usermode, std::string const& chanmode);
+	Reply const RPL_ISUPPORT(std::string const& serverHost, std::string const& nick);
+	Reply const RPL_MOTDSTART(std::string const& serverHost, std::string const& nick);
+	Reply const RPL_MOTD(std::string const& serverHost, std::string const& nick, std::string const& line);
+	Reply const RPL_ENDOFMOTD(std::string const& serverHost, std::string const& nick);
+	Reply const RPL_SUCCESSMODE(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName, std::string const& mode, std::string const& argument);
+	Reply const RPL_CHANNELMODEIS(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& mode, std::string const& argument);
+	Reply const RPL_CREATIONTIME(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& time);
+	Reply const RPL_SUCCESSJOIN(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName);
+	Reply const RPL_TOPIC(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& topic);
+	Reply const RPL_NAMREPLY(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& userList);
+	Reply const RPL_ENDOFNAMES(std::string const& serverHost, std::string const& nick, std::string const& chName);
+	Reply const RPL_SUCCESSQUIT(std::string const& nick, std::string const& user, std::string const& host, std::string const& reason);
+	Reply const RPL_YOUREOPER(std::string const& serverHost, std::string const& nick);
+	Reply const RPL_STATSCOMMANDS(std::string const& serverHost, std::string const& nick, std::string const& command, std::string const& count, std::string const& bytes);
+	Reply const RPL_STATSUPTIME(std::string const& serverHost, std::string const& nick, std::string const& uptime);
+	Reply const RPL_STATSDEBUG(std::string const& serverHost, std::string const& nick, std::string const& text);
+	Reply const RPL_ENDOFSTATS(std::string const& serverHost, std::string const& nick, std::string const& query);
+	Reply const RPL_PING(std::string const& serverHost);
+	Reply const RPL_PONG(std::string const& serverHost);
+	Reply const RPL_PRIVMSG(std::string const& nick, std::string const& user, std::string const& host, std::string const& command, std::string const& target, std::string const& text);
 }
 
 #endif
@@ -5,29 +5,29 @@
 # include <string>
 # include <vector>
 # include <map>
+# include <set>
+# include <stdint.h>
 
 class Client;
 class Channel;
 
+// 클라이언트 핸들. 위 32비트는 슬롯(fd), 아래 32비트는 그 슬롯의 세대. 0은 빈 핸들
+typedef uint64_t ClientHandle;
+
 typedef std::vector<std::string> mesvec;
 typedef std::map<int, std::string> fdmap;
-typedef std::vector<struct kevent> kquvec;
-typedef std::map<int, Client*> cltmap;
-typedef std::map<std::string, Channel*> chlmap;
 typedef std::map<int, Client*> cltmap;
+typedef std::vector<Client*> cltvec;
 typedef std::map<std::string, Channel*> chlmap;
+typedef std::map<ClientHandle, Client*> hdlmap;
+typedef std::map<ClientHandle, size_t> hdlindex;
+typedef std::set<ClientHandle> hdlset;
 
-// 서버에서 명령어를 확인하는 부분
+// 클라이언트의 등록 단계(PASS, NICK, USER를 마쳤는지)를 확인하는 부분
 # define IS_PASS 1 << 0
 # define IS_NICK 1 << 1
 # define IS_USER 1 << 2
 # define IS_LOGIN 7
-# define IS_PING 1 << 3
-# define IS_PONG 1 << 4
-# define IS_MODE 1 << 5
-# define IS_JOIN 1 << 6
-# define IS_QUIT 1 << 7
-# define IS_NOT_ORDER 421
 
 // error와 reply의 숫자, 채널과 클라이언트 쪽에서 사용
 # define TOOMANYCHANNELS 405
@@ -49,7 +49,18 @@ typedef std::map<std::string, Channel*> chlmap;
 # define MAX_CHANNEL 30 // 서버가 최대로 보유할 수 있는 채널 상한
 # define USERNICK_LEN 9 // 사용자 별칭의 최대 길이(RFC 1459)
 # define CHANNELNAME_LEN 200 // 채널 이름 최대 길이(RFC 1459)
+# define SERVERHOST_LEN 15 // 서버 이름 최대 길이(서버 이름은 IPv4 주소)
 # define CHANNEL_LIMIT_PER_USER 10 // 클라이언트 당 참가할 수 있는 채널 상항
+# define MAX_REACTOR 64 // -t 옵션으로 띄울 수 있는 reactor 스레드 상한
+# define MAX_CLIENT_SLOT 65536 // fd로 바로 찾는 클라이언트 슬롯 수 상한(RLIMIT_NOFILE이 더 작으면 그쪽)
+# define CLIENT_SLAB_SIZE 256 // Client를 이만큼씩 한 덩어리로 할당한다
+# define REGISTER_TIMEOUT 30 // 접속 후 등록(PASS, NICK, USER)을 마쳐야 하는 시간(초)
+# define PING_IDLE 90 // 이만큼 조용한 클라이언트에게 서버가 PING을 보낸다(초)
+# define PONG_TIMEOUT 30 // PING을 보낸 뒤 이 안에 아무 소식이 없으면 연결을 끊는다(초)
+# define DEFAULT_MOTD "Hello! This is FT_IRC!" // 처음 띄울 때의 MOTD
+
+// reactor 스레드마다 따로 갖는 전역 변수(POD 타입에만 사용)
+# define THREAD_LOCAL __thread
 
 // system call 실패에 대한 상수
 # define SYS_FAILURE -1
@@ -77,8 +88,15 @@ enum Color {
 
 // 시간 계산 함수
 time_t getCurTime();
+
+// 루프 한 바퀴에 한 번만 시계를 읽고, 그 바퀴 안에서는 저장해둔 값을 쓴다(스레드마다 따로)
+time_t updateCachedTime();
+time_t getCachedTime();
 std::string getStringTime(time_t const& time);
 
 // 메세지에 금지된 문자가 있는 지 확인
 bool chkForbiddenChar(std::string const& str, std::string const& forbidden_set);
+
+// rfc1459 규칙으로 대소문자 접기(A-Z -> a-z, []\^ -> {}|~)
+std::string foldNick(std::string const& nick);
 #endif
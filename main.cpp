@@ -1,5 +1,10 @@
 #include <iostream>
+#include <cstdlib>
+#include <fcntl.h>
 #include "ServerKqueue.hpp"
+#include "Logger.hpp"
+#include "FlightRecorder.hpp"
+#include "ConnClass.hpp"
 
 /**
  * 코딩 컨벤션
@@ -24,23 +29,79 @@
  * REMOVE(파일 삭제)
  */
 
-const static std::string USAGE = "Usage : ./ircserv [port] [password]";
+const static std::string USAGE = "Usage : ./ircserv [port] [password] [-t reactors] [-l logfile] [-T tracefile] [-s slow loop usec] [-x trusted network/bits] [-o name:password]";
 
 int main(int ac, char* av[]) {
-	
-	std::string port = av[1];
-	std::string password = av[2];
+	int reactorCount = 1;
+	int logFd = STDERR_FILENO;
+	std::string tracePath;
+	unsigned long slowLoop = TRACE_SLOW_LOOP;
+	std::string opName;
+	std::string opPassword;
 
-	if (ac != 3) {
+	// 포트, 패스워드 뒤에는 옵션만 올 수 있다
+	if (ac < 3) {
 		Print::printError(USAGE);
 		return 1;
 	}
+	for (int i = 3; i < ac; i++) {
+		std::string option = av[i];
+
+		if (option == "-t" && i + 1 < ac) {
+			reactorCount = std::atoi(av[++i]);
+		} else if (option == "-l" && i + 1 < ac) {
+			if ((logFd = open(av[++i], O_WRONLY | O_CREAT | O_APPEND, 0644)) == SYS_FAILURE) {
+				Print::printError(std::string("Error : cannot open log file ") + av[i]);
+				return 1;
+			}
+		} else if (option == "-T" && i + 1 < ac) {
+			tracePath = av[++i];
+		} else if (option == "-s" && i + 1 < ac) {
+			slowLoop = std::strtoul(av[++i], NULL, 10);
+		} else if (option == "-x" && i + 1 < ac) {
+			// 흐름 제어에서 뺄 네트워크. 주지 않으면 모든 접속이 흐름 제어를 받는다
+			if (!ConnClass::trust(av[++i])) {
+				Print::printError(std::string("Error : invalid trusted network ") + av[i]);
+				return 1;
+			}
+		} else if (option == "-o" && i + 1 < ac) {
+			// OPER로 운영자가 될 이름과 비밀번호. 주지 않으면 아무도 운영자가 될 수 없다
+			std::string credential = av[++i];
+			size_t colon = credential.find(':');
+
+			if (colon == 0 || colon == std::string::npos || colon + 1 == credential.size()) {
+				Print::printError(std::string("Error : invalid operator ") + av[i]);
+				return 1;
+			}
+			opName = credential.substr(0, colon);
+			opPassword = credential.substr(colon + 1);
+		} else {
+			Print::printError(USAGE);
+			return 1;
+		}
+	}
+
+	std::string port = av[1];
+	std::string password = av[2];
 
+#ifdef DEBUG
+	Logger::start(logFd, LOG_DEBUG);
+#else
+	Logger::start(logFd, LOG_INFO);
+#endif
 	try {
-		Server ircServ(port, password);
+		Server ircServ(port, password, reactorCount);
+		if (!opName.empty())
+			ircServ.setOperator(opName, opPassword);
+		// 기록 파일을 줬을 때만 flight recorder를 켠다
+		if (!tracePath.empty())
+			FlightRecorder::start(tracePath, reactorCount, slowLoop, ircServ.getCommandEntries(), ircServ.getCommandCount());
 		ircServ.init();
 		ircServ.loop();
 	} catch (std::exception& e) {
-		Print::printError(e.what());
+		Logger::log(LOG_ERROR, RED, "%s", e.what());
 	}
+	// 서버가 다 정리된 뒤에 기록 파일을 닫고, 남은 로그를 다 쓰고 끝낸다
+	FlightRecorder::stop();
+	Logger::stop();
 }
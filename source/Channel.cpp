@@ -1,6 +1,22 @@
 #include "../../include/Channel.hpp"
+#include "../../include/utils/LineFramer.hpp"
 
-Channel::Channel(std::string chName, Client* client) : chName(chName), chanOp(client), userLimit(0), mode(0), password(""), creationTime(time(NULL)), key("") {
+/**
+ * NAMES 한 줄에 별칭 목록이 쓸 수 있는 길이.
+ * ":<서버> 353 <별칭> = <채널> :"과 CRLF를 뺀 나머지. 서버 이름과 받는 사람 별칭은 최대 길이로 잡는다.
+ */
+static size_t namesBudget(std::string const& chName) {
+	return MESSAGE_LEN - (1 + SERVERHOST_LEN + 5 + USERNICK_LEN + 3 + chName.size() + 2) - 2;
+}
+
+// NAMES에 나오는 이름. 채널 운영자는 앞에 '@'를 붙인다
+static std::string nameOf(Channel const& channel, Client const* client) {
+	if (channel.isChanOp(client))
+		return "@" + client->getNick();
+	return client->getNick();
+}
+
+Channel::Channel(std::string chName, Client* client) : chName(chName), chanOp(client), names(namesBudget(chName)), userLimit(0), mode(0), password(""), creationTime(time(NULL)), key("") {
 }
 
 Channel::~Channel() {
@@ -10,8 +26,17 @@ void Channel::setChName(std::string& name) {
 	this->chName = name;
 }
 
+// 운영자 표시가 옮겨가므로 전 운영자와 새 운영자의 이름만 고친다
 void Channel::setChanOp(Client* client) {
+	Client* old = this->chanOp;
+
+	if (old == client)
+		return ;
 	this->chanOp = client;
+	if (old != NULL && isMember(old))
+		this->names.rename(old->getHandle(), "@" + old->getNick(), old->getNick());
+	if (client != NULL && isMember(client))
+		this->names.rename(client->getHandle(), client->getNick(), "@" + client->getNick());
 }
 
 void Channel::setUserLimit(int userLimit) {
@@ -38,39 +63,70 @@ void Channel::setKey(std::string key) {
 }
 
 void Channel::addInviteList(Client* client) {
-	if (this->inviteList.find(client->getClientFd()) == this->inviteList.end())
-		this->inviteList.insert(std::make_pair(client->getClientFd(), client));
+	this->inviteList.insert(client->getHandle());
 }
 
 void Channel::delInviteList(Client* client) {
-	if (this->inviteList.find(client->getClientFd()) != this->inviteList.end())
-		this->inviteList.erase(client->getClientFd());
+	this->inviteList.erase(client->getHandle());
 }
 
 bool Channel::isClientInvite(Client* client) {
-	if (this->inviteList.find(client->getClientFd()) != this->inviteList.end())
-		return true;
-	return false;
+	return this->inviteList.find(client->getHandle()) != this->inviteList.end();
+}
+
+// 운영자가 나가서 chanOp가 NULL일 수 있으므로 포인터로 비교한다
+bool Channel::isChanOp(Client const* client) const {
+	return this->chanOp != NULL && this->chanOp == client;
+}
+
+bool Channel::isMember(Client const* client) const {
+	return this->userList.find(client->getHandle()) != this->userList.end();
 }
 
 void Channel::addClientList(Client* client) {
-	if (this->userList.find(client->getClientFd()) == this->userList.end())
-		this->userList.insert(std::make_pair(client->getClientFd(), client));
+	if (this->userList.find(client->getHandle()) == this->userList.end()) {
+		this->userList.insert(std::make_pair(client->getHandle(), client));
+		this->memberSlot.insert(std::make_pair(client->getHandle(), this->members.size()));
+		this->members.push_back(client);
+		this->names.add(client->getHandle(), nameOf(*this, client));
+	}
 }
 
+// 빈자리에 마지막 가입자를 옮기고, 옮긴 가입자의 자리만 고친다
 void Channel::deleteClientList(Client* client) {
-	if (this->userList.find(client->getClientFd()) != this->userList.end())
-		this->userList.erase(client->getClientFd());
+	hdlindex::iterator slot = this->memberSlot.find(client->getHandle());
+	Client* last;
+
+	if (slot == this->memberSlot.end())
+		return ;
+	this->userList.erase(client->getHandle());
+	this->names.remove(client->getHandle(), nameOf(*this, client));
+	last = this->members.back();
+	this->members[slot->second] = last;
+	this->memberSlot[last->getHandle()] = slot->second;
+	this->members.pop_back();
+	this->memberSlot.erase(slot);
+}
+
+void Channel::renameClient(Client* client, std::string const& oldNick) {
+	std::string mark = isChanOp(client) ? "@" : "";
+
+	if (isMember(client))
+		this->names.rename(client->getHandle(), mark + oldNick, mark + client->getNick());
 }
 
 Client const& Channel::getChanOp() const {
 	return *this->chanOp;
 }
 
-cltmap const& Channel::getUserList() const {
+hdlmap const& Channel::getUserList() const {
 	return this->userList;
 }
 
+cltvec const& Channel::getMembers() const {
+	return this->members;
+}
+
 int const Channel::getUserLimit() const {
 	return this->userLimit;
 }
@@ -95,17 +151,6 @@ std::string const Channel::getKey() const {
 	return this->key;
 }
 
-std::string const Channel::getStrUserList() const {
-	size_t size = this->userList.size();
-	std::string list = "";
-
-	if (this->chanOp) {
-		list = "@" + this->chanOp->getNick() + " ";
-	}
-	for (cltmap::const_iterator it = this->userList.begin(); it != this->userList.end(); it++)
-		if (it->second != this->chanOp)
-			list += it->second->getNick() + " ";
-	if (list[list.size() - 1] == ' ')
-		list = list.substr(0, list.size() - 1);
-	return list;
+std::vector<std::string> const& Channel::getNames() const {
+	return this->names.getChunks();
 }
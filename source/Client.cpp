@@ -1,16 +1,32 @@
 #include "../include/Client.hpp"
 
-Client::Client(int fd, in_addr info) : passConnect(0), passPing(false), isOperator(false), fd(fd), info(info), host(inet_ntoa(info)), serv(""), nick(""), real("") {
+// inet_ntoa는 정적 버퍼를 돌려주므로 여러 스레드에서 쓰면 안 된다
+static std::string addrToString(in_addr info) {
+	char buf[INET_ADDRSTRLEN];
+
+	if (!inet_ntop(AF_INET, &info, buf, sizeof(buf)))
+		return "";
+	return buf;
+}
+
+Client::Client(int fd, in_addr info, int owner, ClientHandle handle) : passConnect(0), passPing(true), isOperator(false), fd(fd), owner(owner), handle(handle), info(info), host(addrToString(info)), serv(""), nick(""), real(""), nickIndex(NULL), writeArmed(false), readPaused(false), runQueued(false), throttled(false), connClass(&ConnClass::classify(info)) {
+	this->finalTime = getCachedTime();
+	this->timer.owner = this;
+	this->throttleTimer.owner = this;
+	this->floodTokens = this->connClass->floodBurst;
+	this->floodStamp = this->finalTime;
 }
 
 Client::~Client() {
 	chlmap::iterator it = this->joinList.begin();
 
 	for (; it != this->joinList.end(); it++) {
-		if (it->second->getChanOp().getClientFd() == this->fd)
+		if (it->second->isChanOp(this))
 			it->second->setChanOp(NULL);
 		it->second->deleteClientList(this);
 	}
+	if (this->nickIndex != NULL && this->nick != "")
+		this->nickIndex->erase(this->nick, this);
 	close(fd);
 }
 
@@ -50,8 +66,21 @@ void Client::setPassConnect(int flag) {
 	this->passConnect |= flag;
 }
 
+void Client::setOperator(bool flag) {
+	this->isOperator = flag;
+}
+
 void Client::setNick(std::string nick) {
+	std::string old = this->nick;
+
+	if (this->nickIndex != NULL) {
+		if (old != "")
+			this->nickIndex->erase(old, this);
+		this->nickIndex->insert(nick, this);
+	}
 	this->nick = nick;
+	for (chlmap::iterator it = this->joinList.begin(); it != this->joinList.end(); it++)
+		it->second->renameClient(this, old);
 }
 
 void Client::setReal(std::string real) {
@@ -71,7 +100,63 @@ void Client::setServ(std::string serv) {
 }
 
 void Client::setFinalTime() {
-	this->finalTime = time(NULL);
+	this->finalTime = getCachedTime();
+}
+
+void Client::setNickIndex(NickIndex* index) {
+	this->nickIndex = index;
+}
+
+void Client::setWriteArmed(bool flag) {
+	this->writeArmed = flag;
+}
+
+void Client::setReadPaused(bool flag) {
+	this->readPaused = flag;
+}
+
+void Client::setRunQueued(bool flag) {
+	this->runQueued = flag;
+}
+
+void Client::setThrottled(bool flag) {
+	this->throttled = flag;
+}
+
+// 지난번 이후로 지난 초만큼 채운다(상한 floodBurst)
+static void refill(int& tokens, time_t& stamp, ConnClass const& connClass) {
+	time_t now = getCachedTime();
+	time_t elapsed = now - stamp;
+
+	if (elapsed <= 0)
+		return ;
+	// 초마다 한 개 이상 채우므로, 모자란 개수만큼 초가 지났으면 가득 찬다(곱셈 넘침 방지)
+	if (elapsed >= connClass.floodBurst - tokens)
+		tokens = connClass.floodBurst;
+	else if ((tokens += elapsed * connClass.floodRate) > connClass.floodBurst)
+		tokens = connClass.floodBurst;
+	stamp = now;
+}
+
+void Client::chargeFlood(unsigned int cost) {
+	if (this->connClass->floodRate == 0 || cost == 0)
+		return ;
+	refill(this->floodTokens, this->floodStamp, *this->connClass);
+	this->floodTokens -= cost;
+}
+
+bool Client::isFloodLimited() {
+	if (this->connClass->floodRate == 0)
+		return false;
+	refill(this->floodTokens, this->floodStamp, *this->connClass);
+	return this->floodTokens <= 0;
+}
+
+// 토큰이 1개 이상이 되는 시각
+time_t Client::getFloodResumeTime() const {
+	int missing = 1 - this->floodTokens;
+
+	return this->floodStamp + (missing + this->connClass->floodRate - 1) / this->connClass->floodRate;
 }
 
 bool Client::IsOperator() const {
@@ -86,6 +171,14 @@ int Client::getClientFd() const {
 	return this->fd;
 }
 
+int Client::getOwner() const {
+	return this->owner;
+}
+
+ClientHandle Client::getHandle() const {
+	return this->handle;
+}
+
 std::string const& Client::getHost() const {
 	return this->host;
 }
@@ -109,3 +202,43 @@ std::string const& Client::getServ() const {
 time_t const& Client::getTime() const {
 	return this->finalTime;
 }
+
+RecvBuffer& Client::getRecvBuf() {
+	return this->recvBuf;
+}
+
+LineFramer& Client::getFramer() {
+	return this->framer;
+}
+
+bool Client::isWriteArmed() const {
+	return this->writeArmed;
+}
+
+bool Client::isReadPaused() const {
+	return this->readPaused;
+}
+
+bool Client::isRunQueued() const {
+	return this->runQueued;
+}
+
+bool Client::isThrottled() const {
+	return this->throttled;
+}
+
+ConnClass const& Client::getConnClass() const {
+	return *this->connClass;
+}
+
+bool Client::getPassPing() const {
+	return this->passPing;
+}
+
+TimerNode& Client::getTimer() {
+	return this->timer;
+}
+
+TimerNode& Client::getThrottleTimer() {
+	return this->throttleTimer;
+}
@@ -0,0 +1,88 @@
+#include "../include/ClientTable.hpp"
+#include <sys/resource.h>
+#include <new>
+
+ClientTable::ClientTable() {
+	struct rlimit limit;
+	size_t size = MAX_CLIENT_SLOT;
+	Slot empty = { NULL, 0 };
+
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < size)
+		size = limit.rlim_cur;
+	this->slots.assign(size, empty);
+}
+
+ClientTable::~ClientTable() {
+	for (size_t i = 0; i < this->slots.size(); i++)
+		if (this->slots[i].client != NULL)
+			destroy(i);
+	for (size_t i = 0; i < this->slabs.size(); i++)
+		operator delete(this->slabs[i]);
+}
+
+// 빈 자리가 없으면 덩어리 하나를 새로 잡아서 CLIENT_SLAB_SIZE칸으로 자른다
+void* ClientTable::allocate() {
+	void* place;
+
+	if (this->freeList.empty()) {
+		char* slab = static_cast<char*>(operator new(sizeof(Client) * CLIENT_SLAB_SIZE));
+
+		this->slabs.push_back(slab);
+		for (size_t i = CLIENT_SLAB_SIZE; i > 0; i--)
+			this->freeList.push_back(slab + sizeof(Client) * (i - 1));
+	}
+	place = this->freeList.back();
+	this->freeList.pop_back();
+	return place;
+}
+
+Client* ClientTable::create(int fd, in_addr info, int owner) {
+	if (fd < 0 || static_cast<size_t>(fd) >= this->slots.size() || this->slots[fd].client != NULL)
+		return NULL;
+
+	Slot& slot = this->slots[fd];
+
+	// 세대 0은 빈 핸들과 겹치므로 건너뛴다
+	if (++slot.generation == 0)
+		slot.generation = 1;
+	slot.client = new (allocate()) Client(fd, info, owner, makeHandle(fd, slot.generation));
+	return slot.client;
+}
+
+// 파괴자가 채널, 별칭 색인에서 빠지고 fd를 닫는다. 자리는 빈 목록으로 돌아간다
+void ClientTable::destroy(int fd) {
+	Client* client = find(fd);
+
+	if (client == NULL)
+		return ;
+	this->slots[fd].client = NULL;
+	client->~Client();
+	this->freeList.push_back(client);
+}
+
+Client* ClientTable::find(int fd) const {
+	if (fd < 0 || static_cast<size_t>(fd) >= this->slots.size())
+		return NULL;
+	return this->slots[fd].client;
+}
+
+Client* ClientTable::find(ClientHandle handle) const {
+	int fd = handleSlot(handle);
+
+	if (fd < 0 || static_cast<size_t>(fd) >= this->slots.size()
+		|| this->slots[fd].generation != static_cast<uint32_t>(handle))
+		return NULL;
+	return this->slots[fd].client;
+}
+
+size_t ClientTable::capacity() const {
+	return this->slots.size();
+}
+
+ClientHandle ClientTable::makeHandle(int slot, uint32_t generation) {
+	return (static_cast<ClientHandle>(slot) << 32) | generation;
+}
+
+int ClientTable::handleSlot(ClientHandle handle) {
+	return static_cast<int>(handle >> 32);
+}
@@ -0,0 +1,94 @@
+#include "../include/EpollPoller.hpp"
+
+#ifdef USE_EPOLL
+
+#include "../include/utils/utils.hpp"
+#include <stdexcept>
+#include <cerrno>
+#include <unistd.h>
+
+EpollPoller::EpollPoller() {
+	if ((this->epfd = epoll_create(MAX_EVENTS_PER_WAKEUP)) == SYS_FAILURE)
+		throw std::runtime_error("Error : epoll_create");
+}
+
+EpollPoller::~EpollPoller() {
+	close(this->epfd);
+}
+
+uint32_t EpollPoller::toEpoll(int interest) {
+	uint32_t ev = 0;
+
+	if (interest & POLLER_READ)
+		ev |= EPOLLIN | EPOLLRDHUP;
+	if (interest & POLLER_WRITE)
+		ev |= EPOLLOUT;
+	return ev;
+}
+
+void EpollPoller::add(int fd, int interest) {
+	struct epoll_event ev;
+
+	ev.events = toEpoll(interest);
+	ev.data.fd = fd;
+	if (epoll_ctl(this->epfd, EPOLL_CTL_ADD, fd, &ev) == SYS_FAILURE)
+		throw std::runtime_error("Error : epoll_ctl(EPOLL_CTL_ADD)");
+}
+
+void EpollPoller::modify(int fd, int interest) {
+	struct epoll_event ev;
+
+	ev.events = toEpoll(interest);
+	ev.data.fd = fd;
+	if (epoll_ctl(this->epfd, EPOLL_CTL_MOD, fd, &ev) == SYS_FAILURE)
+		throw std::runtime_error("Error : epoll_ctl(EPOLL_CTL_MOD)");
+}
+
+/**
+ * 이미 빠져 있거나(ENOENT) 닫혀서 epoll이 스스로 지운 fd(EBADF)는 목적을 이룬 것이라 넘어간다.
+ * 2.6.9 이전 커널은 EPOLL_CTL_DEL에도 NULL이 아닌 포인터를 요구한다.
+ */
+void EpollPoller::remove(int fd) {
+	struct epoll_event ev;
+
+	if (epoll_ctl(this->epfd, EPOLL_CTL_DEL, fd, &ev) == SYS_FAILURE && errno != ENOENT && errno != EBADF)
+		throw std::runtime_error("Error : epoll_ctl(EPOLL_CTL_DEL)");
+}
+
+/**
+ * epoll_wait 결과를 PollEvent로 옮긴다.
+ * EPOLLHUP, EPOLLRDHUP는 읽기 이벤트로도 같이 올려서 recv가 0을 돌려주게 하고,
+ * 그 결과로 클라이언트가 정리되도록 한다.
+ */
+int EpollPoller::wait(PollEvent* out, int maxEvents, int timeout) {
+	int cnt;
+
+	if (maxEvents > MAX_EVENTS_PER_WAKEUP)
+		maxEvents = MAX_EVENTS_PER_WAKEUP;
+	cnt = epoll_wait(this->epfd, this->events, maxEvents, timeout);
+	if (cnt == SYS_FAILURE)
+		return errno == EINTR ? 0 : SYS_FAILURE;
+
+	for (int i = 0; i < cnt; i++) {
+		uint32_t ev = this->events[i].events;
+
+		out[i].fd = this->events[i].data.fd;
+		out[i].events = 0;
+		out[i].data = 0;
+		if (ev & EPOLLIN)
+			out[i].events |= POLLER_READ;
+		if (ev & EPOLLOUT)
+			out[i].events |= POLLER_WRITE;
+		if (ev & (EPOLLHUP | EPOLLRDHUP))
+			out[i].events |= POLLER_EOF | POLLER_READ;
+		if (ev & EPOLLERR)
+			out[i].events |= POLLER_ERROR;
+	}
+	return cnt;
+}
+
+char const* EpollPoller::getName() const {
+	return "epoll";
+}
+
+#endif
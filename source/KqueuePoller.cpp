@@ -0,0 +1,92 @@
+#include "../include/KqueuePoller.hpp"
+
+#ifdef USE_KQUEUE
+
+#include "../include/utils/utils.hpp"
+#include <stdexcept>
+#include <cerrno>
+#include <unistd.h>
+
+KqueuePoller::KqueuePoller() {
+	if ((this->kq = kqueue()) == SYS_FAILURE)
+		throw std::runtime_error("kqueue error!");
+}
+
+KqueuePoller::~KqueuePoller() {
+	close(this->kq);
+}
+
+void KqueuePoller::pushChange(int fd, int16_t filter, uint16_t flags) {
+	struct kevent toPut;
+
+	EV_SET(&toPut, fd, filter, flags, 0, 0, NULL);
+	this->changeList.push_back(toPut);
+}
+
+/**
+ * kqueue는 필터별로 등록하므로 읽기와 쓰기를 둘 다 등록해 두고,
+ * 관심이 없는 쪽은 EV_DISABLE로 꺼둔다. 이후 modify는 EV_ENABLE, EV_DISABLE만 바꾼다.
+ */
+void KqueuePoller::add(int fd, int interest) {
+	pushChange(fd, EVFILT_READ, EV_ADD | (interest & POLLER_READ ? EV_ENABLE : EV_DISABLE));
+	pushChange(fd, EVFILT_WRITE, EV_ADD | (interest & POLLER_WRITE ? EV_ENABLE : EV_DISABLE));
+}
+
+void KqueuePoller::modify(int fd, int interest) {
+	pushChange(fd, EVFILT_READ, interest & POLLER_READ ? EV_ENABLE : EV_DISABLE);
+	pushChange(fd, EVFILT_WRITE, interest & POLLER_WRITE ? EV_ENABLE : EV_DISABLE);
+}
+
+/**
+ * close 시 kqueue가 등록을 지우므로, 여기서는 아직 커널에 넘기지 않은 변경만 버린다.
+ * 남겨두면 다음 kevent에서 닫힌 fd에 대한 EV_ERROR가 돌아온다.
+ */
+void KqueuePoller::remove(int fd) {
+	for (kquvec::iterator it = this->changeList.begin(); it != this->changeList.end();) {
+		if (static_cast<int>(it->ident) == fd)
+			it = this->changeList.erase(it);
+		else
+			it++;
+	}
+}
+
+int KqueuePoller::wait(PollEvent* out, int maxEvents, int timeout) {
+	struct timespec ts;
+	struct timespec* tsp = NULL;
+	int cnt;
+
+	if (maxEvents > MAX_EVENTS_PER_WAKEUP)
+		maxEvents = MAX_EVENTS_PER_WAKEUP;
+	if (timeout >= 0) {
+		ts.tv_sec = timeout / 1000;
+		ts.tv_nsec = (timeout % 1000) * 1000000;
+		tsp = &ts;
+	}
+	cnt = kevent(this->kq, this->changeList.empty() ? NULL : &this->changeList[0], this->changeList.size(), this->events, maxEvents, tsp);
+	this->changeList.clear();
+	if (cnt == SYS_FAILURE)
+		return errno == EINTR ? 0 : SYS_FAILURE;
+
+	for (int i = 0; i < cnt; i++) {
+		struct kevent& cur = this->events[i];
+
+		out[i].fd = static_cast<int>(cur.ident);
+		out[i].events = 0;
+		out[i].data = cur.data;
+		if (cur.flags & EV_ERROR)
+			out[i].events |= POLLER_ERROR;
+		else if (cur.filter == EVFILT_READ)
+			out[i].events |= POLLER_READ;
+		else if (cur.filter == EVFILT_WRITE)
+			out[i].events |= POLLER_WRITE;
+		if (cur.flags & EV_EOF)
+			out[i].events |= POLLER_EOF;
+	}
+	return cnt;
+}
+
+char const* KqueuePoller::getName() const {
+	return "kqueue";
+}
+
+#endif
@@ -0,0 +1,36 @@
+#include "../include/Poller.hpp"
+#include "../include/EpollPoller.hpp"
+#include "../include/KqueuePoller.hpp"
+#include <stdexcept>
+
+Poller::~Poller() {
+}
+
+/**
+ * 빌드 시점에 고른 백엔드를 만든다.
+ * 둘 다 포함되어 있다면 epoll을 우선한다.
+ */
+Poller* Poller::create() {
+#if defined(USE_EPOLL)
+	return new EpollPoller();
+#elif defined(USE_KQUEUE)
+	return new KqueuePoller();
+#else
+	throw std::runtime_error("Error : no poller backend in this build");
+#endif
+}
+
+/**
+ * 이름으로 백엔드를 고른다. 이번 빌드에 포함되지 않은 백엔드면 예외를 던진다.
+ */
+Poller* Poller::create(std::string const& name) {
+#ifdef USE_EPOLL
+	if (name == "epoll")
+		return new EpollPoller();
+#endif
+#ifdef USE_KQUEUE
+	if (name == "kqueue")
+		return new KqueuePoller();
+#endif
+	throw std::runtime_error("Error : poller backend '" + name + "' is not available in this build");
+}
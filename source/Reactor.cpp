@@ -0,0 +1,674 @@
+#include "../include/Reactor.hpp"
+#include "../include/ServerKqueue.hpp"
+#include "../include/utils/reply.hpp"
+#include "../include/utils/Logger.hpp"
+#include <fcntl.h>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <strings.h>
+
+THREAD_LOCAL Reactor* Reactor::current = NULL;
+
+Reactor::Reactor(Server& server, int id) : server(server), id(id), poller(NULL), listenSocket(-1), stats(server.getCommandEntries(), server.getCommandCount()),
+	published(server.getCommandEntries(), server.getCommandCount()), publishLock(false),
+#ifdef PROFILE
+	profiler(id),
+#endif
+	mailLock(false) {
+	this->wakePipe[0] = -1;
+	this->wakePipe[1] = -1;
+	this->poller = Poller::create();
+}
+
+Reactor::~Reactor() {
+	for (size_t fd = 0; fd < this->clients.size(); fd++)
+		if (this->clients[fd] != NULL)
+			this->poller->remove(fd);
+	if (this->listenSocket != -1)
+		close(this->listenSocket);
+	for (size_t i = 0; i < this->mailbox.size(); i++)
+		this->mailbox[i].payload->release();
+	if (this->wakePipe[0] != -1) {
+		close(this->wakePipe[0]);
+		close(this->wakePipe[1]);
+	}
+	delete this->poller;
+}
+
+// reactor 초기화
+void Reactor::init(int port, bool reusePort) {
+	struct sockaddr_in servAddr;
+	int isReuse = 1;
+
+	// 서버의 소켓을 연다. PF_INET는 IPv4,
+	// SOCK_STREAM은 TCP 프로토콜을 사용하는 연결 지향형 소켓
+	if ((this->listenSocket = socket(PF_INET, SOCK_STREAM, 0)) == SYS_FAILURE)
+		throw std::runtime_error("Error : server socket is wrong");
+
+	// 서버의 주소 값을 초기화, socket_internet의 family, address, port를 지정
+	memset(&servAddr, 0, sizeof(servAddr));
+	servAddr.sin_family = AF_INET;
+	servAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAddr.sin_port = htons(port);
+
+	// SO_REUSEADDR: 이전에 사용된 주소와 포트를 즉시 재사용
+	// SO_REUSEPORT: reactor마다 같은 포트로 리슨 소켓을 따로 열고, 커널이 새 연결을 나눠주도록 한다
+	setsockopt(this->listenSocket, SOL_SOCKET, SO_REUSEADDR, &isReuse, sizeof(isReuse));
+	if (reusePort && setsockopt(this->listenSocket, SOL_SOCKET, SO_REUSEPORT, &isReuse, sizeof(isReuse)) == SYS_FAILURE)
+		throw std::runtime_error("Error : SO_REUSEPORT");
+
+	// 서버 소켓에 주소를 할당하고, 연결 대기 상태로 만든다
+	if (bind(this->listenSocket, (struct sockaddr*)&servAddr, sizeof(servAddr)) == SYS_FAILURE)
+		throw std::runtime_error("Error : bind");
+	if (listen(this->listenSocket, CONNECT) == SYS_FAILURE)
+		throw std::runtime_error("Error : listen");
+	fcntl(this->listenSocket, F_SETFL, O_NONBLOCK);
+
+	// 클라이언트가 새로 연결을 요청하면 리슨 소켓에 읽기 이벤트가 발생하고, addClient에서 이를 받는다.
+	this->poller->add(this->listenSocket, POLLER_READ);
+	initDetached();
+}
+
+// 리슨 소켓 없이 우편함 파이프만 연다. 클라이언트는 attachClient로 붙인다
+void Reactor::initDetached() {
+	// 다른 reactor가 우편함에 메세지를 넣었을 때 깨워줄 파이프
+	if (pipe(this->wakePipe) == SYS_FAILURE)
+		throw std::runtime_error("Error : pipe");
+	fcntl(this->wakePipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(this->wakePipe[1], F_SETFL, O_NONBLOCK);
+	this->poller->add(this->wakePipe[0], POLLER_READ);
+}
+
+// 이 스레드에서 쓸 버퍼를 연결하고 타이머 시계를 맞춘다. runOnce 전에 같은 스레드에서 한 번 부른다
+void Reactor::enter() {
+	current = this;
+	Buffer::bind(&this->buffer);
+	Stats::bind(&this->stats);
+	FlightRecorder::bind(this->id);
+#ifdef PROFILE
+	Profiler::bind(&this->profiler);
+#endif
+	this->timers.start(updateCachedTime());
+}
+
+// reactor 루프 (실질적 서버의 동작부)
+void Reactor::run() {
+	enter();
+
+	// 루프로 계속 poller에 이벤트가 있는지 확인한다.
+	while (this->server.isRunning() && runOnce(true))
+		;
+}
+
+/**
+ * 루프 한 바퀴. block이 false면 poller에서 기다리지 않는다(시험 도구가 한 바퀴씩 돌릴 때).
+ * 서버를 멈춰야 하면 false.
+ */
+bool Reactor::runOnce(bool block) {
+	int cntNewEvents;
+	int timeout = 0;
+	unsigned long loopStart;
+	PollEvent newEvents[CNT_EVENT_POOL];
+	std::vector<ClientHandle>& urgent = this->urgentBatch;
+	std::vector<ClientHandle>& bulk = this->runBatch;
+
+	/*
+	poller의 wait는 등록된 fd 중에서 이벤트가 발생한 것을 최대 CNT_EVENT_POOL개까지 newEvents에 채운다.
+	관심 이벤트는 addClient에서 fd 당 한 번만 등록(읽기)해두고, 쓰기 관심은 보낼 내용이 밀린 동안만 켠다.
+	timeout은 타이머 휠에서 가장 가까운 마감까지의 시간이고, 걸린 타이머가 없으면 -1(이벤트가 올 때까지 대기)이다.
+	실행 대기열에 미뤄둔 일이 있으면 기다리지 않는다.
+	계측 사본을 뜬 뒤로 돈 바퀴가 있으면 1초 안에는 깨어나서 사본을 새로 뜬다(쉬는 reactor의 사본이 낡은 채로 남지 않게).
+	깨어나면 시계를 한 번만 읽고, 이번 바퀴에서는 그 값을 쓴다.
+	kqueue는 읽기, 쓰기 이벤트가 각각 따로 오고, epoll은 한 fd의 이벤트가 한 번에 합쳐져서 온다.
+	*/
+	if (block && this->urgentQueue.empty() && this->runQueue.empty()) {
+		timeout = this->timers.nextTimeout(getCachedTime());
+		if (this->stats.getCounter(STAT_LOOPS) != this->published.getCounter(STAT_LOOPS) && (timeout < 0 || timeout > STATS_PUBLISH_WAIT))
+			timeout = STATS_PUBLISH_WAIT;
+	}
+	PROFILE_BEGIN_WAIT();
+	cntNewEvents = this->poller->wait(newEvents, CNT_EVENT_POOL, timeout);
+	PROFILE_END_WAIT(cntNewEvents);
+	updateCachedTime();
+	loopStart = FlightRecorder::isActive() ? FlightRecorder::now() : 0;
+	if (cntNewEvents == SYS_FAILURE) {
+		this->server.stop();
+		return false;
+	}
+	Stats::count(STAT_LOOPS);
+
+	// 지난 바퀴까지 미뤄둔 클라이언트. 이번 바퀴에 새로 미뤄지는 건 다음 바퀴에 처리한다
+	urgent.clear();
+	bulk.clear();
+	urgent.swap(this->urgentQueue);
+	bulk.swap(this->runQueue);
+
+	for (int i = 0; i < cntNewEvents; i++) {
+		PollEvent const& cur = newEvents[i];
+
+		if (isServerEvent(cur.fd)) {
+			if (cur.events & POLLER_ERROR) {
+				this->server.stop();
+				break ;
+			}
+			Stats::count(STAT_EV_ACCEPT);
+			addClient(cur.fd);
+			continue ;
+		}
+		if (cur.fd == this->wakePipe[0]) {
+			Stats::count(STAT_EV_WAKE);
+			drainMailbox();
+			continue ;
+		}
+
+		// fd로 한 번만 찾고, 이후로는 Client를 그대로 넘긴다
+		Client* client = findClient(cur.fd);
+
+		if (client == NULL)
+			continue ;
+		if (cur.events & POLLER_ERROR) {
+			Stats::count(STAT_EV_ERROR);
+			deleteClient(cur.fd, CLOSE_ERROR);
+			continue ;
+		}
+		if (cur.events & POLLER_READ) {
+			Stats::count(STAT_EV_READ);
+			handleReadEvent(*client);
+		}
+		// 읽다가 연결이 끊겼을 수 있다
+		if ((cur.events & POLLER_WRITE) && (client = findClient(cur.fd)) != NULL) {
+			Stats::count(STAT_EV_WRITE);
+			handleWriteEvent(*client);
+		}
+	}
+	// 미뤄둔 클라이언트를 급한 쪽부터 한 번씩 이어서 처리한다
+	runQueued(urgent);
+	runQueued(bulk);
+
+	// 새 이벤트에 대한 처리가 끝난 이후에, 마감이 지난 클라이언트를 확인한다.
+	handleTimers();
+
+	// 이번 루프에서 쌓인 응답(타이머가 보낸 PING 포함)을 fd당 한 번씩 보낸다
+	flushPendingWrites();
+
+	// 큐 깊이는 초가 바뀔 때만 훑고, 그때 사본도 뜬다. 시그널로 덤프를 요청받았으면 첫 번째 reactor가 남긴다
+	if (this->stats.isDepthStale(getCachedTime())) {
+		sampleDepth();
+		publishStats();
+	}
+	if (this->id == 0 && Stats::takeDumpRequest())
+		this->server.dumpStats();
+	PROFILE_REPORT(getCachedTime());
+
+	// 바퀴 하나를 기록에 남긴다. 느렸거나 시그널로 요청받았으면 기록 파일을 덤프한다
+	FlightRecorder::endLoop(loopStart, cntNewEvents);
+	if (this->id == 0 && FlightRecorder::takeDumpRequest())
+		FlightRecorder::dump(0);
+	return this->server.isRunning();
+}
+
+void* Reactor::threadMain(void* arg) {
+	Reactor* reactor = static_cast<Reactor*>(arg);
+
+	try {
+		reactor->run();
+	} catch (std::exception& e) {
+		Logger::log(LOG_ERROR, RED, "%s", e.what());
+		reactor->server.stop();
+	}
+	return NULL;
+}
+
+void Reactor::start() {
+	if (pthread_create(&this->thread, NULL, &Reactor::threadMain, this) != 0)
+		throw std::runtime_error("Error : pthread_create");
+}
+
+void Reactor::join() {
+	pthread_join(this->thread, NULL);
+}
+
+void Reactor::addClient(int fd) {
+	PROFILE_SCOPE(PHASE_ACCEPT);
+	int clientSocket;
+	struct sockaddr_in clntAdr;
+	socklen_t clntSz;
+
+	clntSz = sizeof(clntAdr);
+	if ((clientSocket = accept(fd, (struct sockaddr*)&clntAdr, &clntSz)) == SYS_FAILURE) {
+		// 다른 reactor와 같은 연결을 두고 경쟁했거나, 이미 연결이 끊긴 경우
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED)
+			return ;
+		throw std::runtime_error("Error : accept!()");
+	}
+	attachClient(clientSocket, clntAdr.sin_addr);
+}
+
+/**
+ * 이미 연결된 소켓을 이 reactor의 클라이언트로 붙인다. info는 접속 등급과 호스트 이름을 정한다.
+ * accept 한 소켓 말고도 시험 도구의 socketpair도 이리로 붙인다.
+ */
+Client* Reactor::attachClient(int clientSocket, in_addr info) {
+	Client* client;
+
+	fcntl(clientSocket, F_SETFL, O_NONBLOCK);
+	// 클라이언트 슬롯을 넘는 fd는 받지 않는다
+	if ((client = this->server.registerClient(clientSocket, info, this->id)) == NULL) {
+		close(clientSocket);
+		return NULL;
+	}
+	if (static_cast<size_t>(clientSocket) >= this->clients.size())
+		this->clients.resize(clientSocket + 1, NULL);
+	this->clients[clientSocket] = client;
+	Buffer::resetSendBuf(clientSocket, client->getConnClass().sendqHard);
+	this->timers.schedule(&client->getTimer(), getCachedTime() + REGISTER_TIMEOUT);
+	// 쓰기 관심은 보낼 내용이 밀렸을 때만 켠다(flushPendingWrites)
+	this->poller->add(clientSocket, POLLER_READ);
+	FlightRecorder::record(TRACE_ACCEPT, clientSocket, info.s_addr);
+
+	Logger::log(LOG_INFO, GREEN, "Connected Client : %d (%s)", clientSocket, client->getHost().c_str());
+	return client;
+}
+
+/**
+ * poller에서 먼저 빼고, 서버 명단에서 지운다(Client 소멸자가 fd를 닫는다).
+ * fd가 닫히기 전에 버퍼와 이 reactor의 명단에서도 지워서, 재사용된 fd와 섞이지 않도록 한다.
+ */
+void Reactor::deleteClient(int fd, TraceClose reason) {
+	PROFILE_SCOPE(PHASE_CLOSE);
+	Client* client = findClient(fd);
+
+	if (client == NULL)
+		return ;
+	FlightRecorder::record(TRACE_CLOSE, fd, 0, 0, reason);
+	this->poller->remove(fd);
+	this->timers.cancel(&client->getTimer());
+	this->timers.cancel(&client->getThrottleTimer());
+	Buffer::eraseSendBuf(fd);
+	this->clients[fd] = NULL;
+	this->server.unregisterClient(fd);
+	Logger::log(LOG_INFO, RED, "Disconnected Client : %d", fd);
+}
+
+/**
+ * 마감이 지난 클라이언트만 처리한다(전체를 훑지 않는다).
+ * 1. 등록을 마치지 못했으면 끊는다
+ * 2. PING을 보낸 뒤(passPing이 false) 아무 소식이 없었으면 끊는다
+ * 3. PING_IDLE 동안 조용했으면 PING을 보내고 마감을 PONG_TIMEOUT 뒤로 옮긴다
+ * 4. 그 사이에 소식이 있었으면 마지막 소식 + PING_IDLE로 미룬다
+ *	a. 읽을 때마다 휠을 건드리지 않고, 마감이 왔을 때 한 번에 미룬다
+ * 흐름 제어로 멈춘 클라이언트의 타이머는 먼저 따로 풀어준다.
+ * 끊는 쪽을 나중에 해야, 끊긴 클라이언트의 노드를 같은 목록에서 다시 만지지 않는다.
+ */
+void Reactor::handleTimers() {
+	PROFILE_SCOPE(PHASE_TIMERS);
+	time_t now = getCachedTime();
+	std::vector<TimerNode*> expired;
+	std::vector<std::pair<ClientHandle, bool> > fired;
+
+	/**
+	 * 처리 도중 끊긴 클라이언트의 노드는 해제된 메모리라, 건드리기 전에 핸들과 흐름 제어 타이머인지만 모아두고
+	 * ClientTable에서 매번 다시 찾는다
+	 */
+	this->timers.advance(now, expired);
+	Stats::count(STAT_EV_TIMER, expired.size());
+	for (size_t i = 0; i < expired.size(); i++) {
+		Client* client = static_cast<Client*>(expired[i]->owner);
+
+		fired.push_back(std::make_pair(client->getHandle(), expired[i] == &client->getThrottleTimer()));
+	}
+	// 흐름 제어가 풀린 클라이언트를 먼저 다시 읽게 한다
+	for (size_t i = 0; i < fired.size(); i++) {
+		Client* client = this->server.getClients().find(fired[i].first);
+
+		if (!fired[i].second || client == NULL)
+			continue ;
+		client->setThrottled(false);
+		FlightRecorder::record(TRACE_TIMER, client->getClientFd(), 0, 0, TIMER_UNTHROTTLE);
+		updateInterest(*client);
+	}
+	for (size_t i = 0; i < fired.size(); i++) {
+		Client* client = this->server.getClients().find(fired[i].first);
+		int fd;
+
+		if (fired[i].second || client == NULL)
+			continue ;
+		fd = client->getClientFd();
+		if ((client->getPassConnect() & IS_LOGIN) != IS_LOGIN)
+			closeClient(fd, "Registration timed out", CLOSE_REGISTER_TIMEOUT);
+		else if (!client->getPassPing())
+			closeClient(fd, "Ping timeout", CLOSE_PING_TIMEOUT);
+		else if (now - client->getTime() >= PING_IDLE) {
+			FlightRecorder::record(TRACE_TIMER, fd, 0, 0, TIMER_PING);
+			Buffer::sendMessage(fd, reply::RPL_PING(this->server.getHost()));
+			client->setPassPing(false);
+			this->timers.schedule(&client->getTimer(), now + PONG_TIMEOUT);
+		} else {
+			FlightRecorder::record(TRACE_TIMER, fd, 0, 0, TIMER_RESCHEDULE);
+			this->timers.schedule(&client->getTimer(), client->getTime() + PING_IDLE);
+		}
+	}
+}
+
+// 쌓인 응답과 ERROR를 바로 보내 보고(다 못 보내도 기다리지 않는다) 끊는다
+void Reactor::closeClient(int fd, std::string const& reason, TraceClose code) {
+	Buffer::sendMessage(fd, error::ERROR_CLOSINGLINK(findClient(fd)->getHost(), reason));
+	Buffer::sendMessage(fd);
+	deleteClient(fd, code);
+}
+
+void Reactor::evictClient(int fd) {
+	Client* client = findClient(fd);
+
+	if (client == NULL)
+		return ;
+	Buffer::resetSendBuf(fd, client->getConnClass().sendqHard);
+	Stats::count(STAT_SENDQ_EVICTIONS);
+	Logger::log(LOG_WARN, YELLOW, "SendQ exceeded : %d", fd);
+	closeClient(fd, "SendQ exceeded", CLOSE_SENDQ);
+}
+
+// 대기열에 올라가 있으면 recv만 한다. 처리는 대기열 차례에 한다
+void Reactor::handleReadEvent(Client& client) {
+	PROFILE_SCOPE(PHASE_READ);
+	int byte;
+
+	byte = Buffer::readMessage(client);
+	FlightRecorder::record(TRACE_READ, client.getClientFd(), byte);
+	Stats::count(STAT_RECV_CALLS);
+
+	/**
+	 * 무엇이든 받았을 때만 살아 있는 것으로 친다(PING에 대한 답으로 친다).
+	 * 0이면 연결이 끊긴 것이고, EAGAIN(수신 버퍼가 가득 찬 경우 포함), EINTR이 아닌 오류도 끊긴 것으로 본다.
+	 * 오류가 읽기 이벤트로만 오면, 여기서 끊지 않는 한 같은 이벤트가 계속 온다.
+	 */
+	if (byte > 0) {
+		Stats::count(STAT_BYTES_IN, byte);
+		client.setFinalTime();
+		client.setPassPing(true);
+	} else if (byte == 0)
+		return deleteClient(client.getClientFd(), CLOSE_EOF);
+	else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+		return deleteClient(client.getClientFd(), CLOSE_ERROR);
+	if (!client.isRunQueued())
+		processLines(client);
+}
+
+// 명령어 이름이 PING, PONG인지(대소문자 무시)
+static bool isKeepalive(char const* data, size_t size) {
+	return size >= 4 && (size == 4 || data[4] == ' ')
+		&& (strncasecmp(data, "PING", 4) == 0 || strncasecmp(data, "PONG", 4) == 0);
+}
+
+/**
+ * 수신 버퍼의 완성된 줄을 접속 등급의 처리 한도(명령 수, 바이트 수)까지만 실행한다.
+ * PING, PONG은 바이트는 세지만 명령 수에는 세지 않는다.
+ * 한도를 다 썼는데 버퍼에 남은 게 있으면 실행 대기열에 올린다.
+ * 흐름 제어 토큰을 다 썼으면 대기열 대신 토큰이 찰 시각에 타이머를 걸고 읽기를 멈춘다.
+ */
+void Reactor::processLines(Client& client) {
+	PROFILE_SCOPE(PHASE_FRAME);
+	int fd = client.getClientFd();
+	RecvBuffer& recvBuf = client.getRecvBuf();
+	LineFramer& framer = client.getFramer();
+	ConnClass const& connClass = client.getConnClass();
+	size_t lines = 0;
+	size_t bytes = 0;
+	StrView line;
+	int frame;
+
+	while (lines < connClass.lineBudget && bytes < connClass.byteBudget) {
+		if (client.isFloodLimited()) {
+			Stats::count(STAT_FLOOD_THROTTLES);
+			client.setThrottled(true);
+			this->timers.schedule(&client.getThrottleTimer(), client.getFloodResumeTime());
+			return updateInterest(client);
+		}
+		if ((frame = framer.next(recvBuf, line)) == FRAME_NONE)
+			return ;
+		if (frame == FRAME_TOOLONG) {
+			Buffer::sendMessage(fd, error::ERR_INPUTTOOLONG(this->server.getHost()));
+			lines++;
+			continue;
+		}
+		bytes += line.size;
+		Stats::count(STAT_LINES_IN);
+		// 명령어가 없는 줄은 조용히 무시한다
+		if (!this->message.parse(line))
+			continue;
+		if (!isKeepalive(this->message.getCommand().data, this->message.getCommand().size))
+			lines++;
+
+		// 공유 상태를 건드리는 명령어 실행만 잠금 안에서 한다
+		{
+			ScopedLock lock(this->server.getStateLock());
+			this->server.runCommand(client, this->message);
+		}
+		// QUIT 등으로 클라이언트가 사라졌으면 남은 내용은 버린다
+		if (!this->containsCurrentEvent(fd))
+			return ;
+	}
+	if (recvBuf.size() > 0)
+		enqueueRun(client);
+}
+
+/**
+ * 등록을 마치지 못했거나 다음 줄이 PING, PONG이면 급한 대기열에 올린다.
+ * 한 클라이언트는 대기열에 한 번만 올라간다.
+ */
+void Reactor::enqueueRun(Client& client) {
+	RecvBuffer const& recvBuf = client.getRecvBuf();
+
+	if (client.isRunQueued())
+		return ;
+	client.setRunQueued(true);
+	if ((client.getPassConnect() & IS_LOGIN) != IS_LOGIN || isKeepalive(recvBuf.begin(), recvBuf.size()))
+		this->urgentQueue.push_back(client.getHandle());
+	else
+		this->runQueue.push_back(client.getHandle());
+}
+
+/**
+ * 대기열에 올린 뒤에 나간 클라이언트는 핸들이 맞지 않으니 건너뛴다.
+ * 송신 큐가 밀렸거나 흐름 제어로 읽기를 멈춘 클라이언트는 내려두고, 다시 읽기를 켤 때(updateInterest) 올린다.
+ */
+void Reactor::runQueued(std::vector<ClientHandle> const& batch) {
+	for (size_t i = 0; i < batch.size(); i++) {
+		Client* client = findClient(ClientTable::handleSlot(batch[i]));
+
+		if (client == NULL || client->getHandle() != batch[i])
+			continue ;
+		client->setRunQueued(false);
+		if (!client->isReadPaused())
+			processLines(*client);
+	}
+}
+
+/**
+ * 밀린 내용을 마저 보낸다. 다 보냈으면 쓰기 관심을 끄고, 멈춰둔 읽기도 다시 켠다.
+ * 쓸 수 있다는 건 클라이언트가 보낸 소식이 아니므로 finalTime은 건드리지 않는다.
+ */
+void Reactor::handleWriteEvent(Client& client) {
+	PROFILE_SCOPE(PHASE_WRITE);
+	int fd = client.getClientFd();
+
+	if (Buffer::sendMessage(fd) == SYS_FAILURE)
+		return deleteClient(fd, CLOSE_SEND_FAILED);
+	updateInterest(client);
+}
+
+/**
+ * 이번 루프 동안 명령어 실행, 우편함 비우기로 쌓인 응답을 보낸다.
+ * 등록 과정처럼 응답이 여러 줄이어도 fd당 writev 한 번이다.
+ * 소켓이 가득 차서 남은 fd만 쓰기 관심을 켜고, 나머지는 쓰기 이벤트로 깨어나지 않는다.
+ * 송신 큐 한도를 넘긴 fd는 여기서 끊는다(명령어 실행이나 방송 도중에는 끊지 않는다).
+ */
+void Reactor::flushPendingWrites() {
+	PROFILE_SCOPE(PHASE_FLUSH);
+	std::vector<int> failed;
+	std::vector<int> blocked;
+	std::vector<int> overflowed;
+
+	Buffer::flushPending(failed, blocked, overflowed);
+	for (size_t i = 0; i < failed.size(); i++)
+		deleteClient(failed[i], CLOSE_SEND_FAILED);
+	for (size_t i = 0; i < overflowed.size(); i++)
+		evictClient(overflowed[i]);
+	for (size_t i = 0; i < blocked.size(); i++) {
+		Client* client = findClient(blocked[i]);
+
+		if (client != NULL)
+			updateInterest(*client);
+	}
+}
+
+/**
+ * 보낼 게 남았으면 쓰기 관심을 켠다.
+ * 남은 양이 등급의 sendqSoft 이상이면 읽기 관심을 꺼서, 받아가지 않는 클라이언트의 명령(과 그 응답)을 더 받지 않는다.
+ * 흐름 제어로 멈춘 동안에도 읽기 관심을 끈다. 그동안 보낸 내용은 커널 소켓 버퍼에 쌓였다가 보내는 쪽을 막는다.
+ * 바뀐 게 있을 때만 poller를 건드린다.
+ */
+void Reactor::updateInterest(Client& client) {
+	size_t pending = Buffer::getPending(client.getClientFd());
+	bool write = pending > 0;
+	bool pause = pending >= client.getConnClass().sendqSoft || client.isThrottled();
+
+	if (write == client.isWriteArmed() && pause == client.isReadPaused())
+		return ;
+	this->poller->modify(client.getClientFd(), (pause ? 0 : POLLER_READ) | (write ? POLLER_WRITE : 0));
+	client.setWriteArmed(write);
+	// 멈춰 있던 동안 처리하지 못한 줄이 남았으면 이어서 처리한다
+	if (client.isReadPaused() && !pause && client.getRecvBuf().size() > 0)
+		enqueueRun(client);
+	client.setReadPaused(pause);
+}
+
+/**
+ * 우편함은 잠금 안에서 통째로 바꿔치기하고, 실제 전송은 잠금 밖에서 한다.
+ * 우편을 넣은 뒤에 클라이언트가 나갔거나 fd가 다른 클라이언트에게 재사용되었으면 버린다.
+ */
+void Reactor::drainMailbox() {
+	PROFILE_SCOPE(PHASE_MAILBOX);
+	std::vector<Mail> mails;
+	char drain[64];
+
+	while (read(this->wakePipe[0], drain, sizeof(drain)) > 0)
+		;
+	{
+		ScopedLock lock(this->mailLock);
+		mails.swap(this->mailbox);
+	}
+	for (size_t i = 0; i < mails.size(); i++) {
+		Client* client = findClient(ClientTable::handleSlot(mails[i].handle));
+
+		if (client != NULL && client->getHandle() == mails[i].handle)
+			Buffer::sendPayload(client->getClientFd(), mails[i].payload);
+		mails[i].payload->release();
+	}
+}
+
+void Reactor::post(ClientHandle handle, Payload* payload) {
+	bool wasEmpty;
+	Mail mail;
+
+	payload->retain();
+	mail.handle = handle;
+	mail.payload = payload;
+	{
+		ScopedLock lock(this->mailLock);
+		wasEmpty = this->mailbox.empty();
+		this->mailbox.push_back(mail);
+	}
+	// 이미 우편이 쌓여 있으면 깨우는 중이므로 다시 쓰지 않는다
+	if (wasEmpty)
+		wakeUp();
+}
+
+void Reactor::wakeUp() {
+	char c = 0;
+
+	if (this->wakePipe[1] != -1)
+		write(this->wakePipe[1], &c, 1);
+}
+
+/**
+ * 현재 reactor가 맡지 않은 fd로 보내는 메세지를 주인 reactor의 우편함에 넣는다.
+ * 서버 명단을 보므로, 명령어 실행 중(stateLock을 잡은 상태)에만 불러야 한다.
+ */
+void Reactor::forward(int fd, Payload* payload) {
+	Client* client = current->server.getClients().find(fd);
+	Reactor* owner;
+
+	if (client == NULL)
+		return ;
+	if ((owner = current->server.getReactor(client->getOwner())) == NULL || owner == current)
+		return ;
+	owner->post(client->getHandle(), payload);
+}
+
+Client* Reactor::findClient(int fd) const {
+	if (fd < 0 || static_cast<size_t>(fd) >= this->clients.size())
+		return NULL;
+	return this->clients[fd];
+}
+
+bool Reactor::containsCurrentEvent(int ident) {
+	return findClient(ident) != NULL;
+}
+
+bool Reactor::isServerEvent(int ident) {
+	return (ident == this->listenSocket);
+}
+
+int Reactor::getId() const {
+	return this->id;
+}
+
+// 명령어 수만큼의 히스토그램을 복사하지만 크기가 같아서 할당은 없다
+void Reactor::publishStats() {
+	ScopedLock lock(this->publishLock);
+
+	this->published = this->stats;
+}
+
+void Reactor::mergeStats(Stats& out) {
+	if (current == this) {
+		out.merge(this->stats);
+		return ;
+	}
+	ScopedLock lock(this->publishLock);
+
+	out.merge(this->published);
+}
+
+void Reactor::sampleDepth() {
+	size_t count = 0;
+	size_t sendqTotal = 0;
+	size_t sendqMax = 0;
+	size_t recvqTotal = 0;
+	size_t recvqMax = 0;
+
+	for (size_t fd = 0; fd < this->clients.size(); fd++) {
+		Client* client = this->clients[fd];
+		size_t sendq;
+		size_t recvq;
+
+		if (client == NULL)
+			continue ;
+		count++;
+		sendq = Buffer::getPending(fd);
+		recvq = client->getRecvBuf().size();
+		sendqTotal += sendq;
+		recvqTotal += recvq;
+		if (sendq > sendqMax)
+			sendqMax = sendq;
+		if (recvq > recvqMax)
+			recvqMax = recvq;
+	}
+	this->stats.setDepth(getCachedTime(), count, sendqTotal, sendqMax, recvqTotal, recvqMax);
+}
+
+Reactor* Reactor::getCurrent() {
+	return current;
+}
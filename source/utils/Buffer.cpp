@@ -1,103 +1,164 @@
 #include "../../include/utils/Buffer.hpp"
 #include "../../include/utils/Print.hpp"
+#include "../../include/utils/Stats.hpp"
+#include "../../include/utils/FlightRecorder.hpp"
+#include "../../include/Reactor.hpp"
+#include "../../include/Client.hpp"
 #include <sys/socket.h>
+#include <cstring>
 
-fdmap Buffer::bufForRead;
-fdmap Buffer::bufForSend;
+THREAD_LOCAL Buffer* Buffer::local = NULL;
 
-int const Buffer::readMessage(int fd, intptr_t data) {
-	char buf[data + 1];
-	int byte;
+Buffer::~Buffer() {
+	for (size_t i = 0; i < this->queues.size(); i++)
+		delete this->queues[i];
+}
 
-	memset(buf, 0, sizeof(buf));
-	byte = recv(fd, buf, data, 0);
-	bufForRead[fd] += buf;
-	return byte;
+void Buffer::bind(Buffer* buffer) {
+	local = buffer;
 }
 
-int const Buffer::sendMessage(int fd) {
-	int size = 0;
-
-	if (bufForSend[fd] != "") {
-		std::string mes = 0;
-
-		mes = bufForSend[fd];
-		size = send(fd, &mes[0], mes.size(), 0);
-		if (size == SYS_FAILURE)
-			return SYS_FAILURE;
-		bufForSend[fd] = "";
-		if (size < mes.size()) {
-			bufForSend[fd] = mes.substr(size, mes.size());
-		}
-	}
-	return size;
+SendQueue* Buffer::findQueue(int fd) {
+	if (fd < 0 || static_cast<size_t>(fd) >= local->queues.size())
+		return NULL;
+	return local->queues[fd];
+}
+
+bool Buffer::isLocal(int fd) {
+	return findQueue(fd) != NULL;
 }
 
-int const Buffer::sendMessage(int fd, std::string message) {
-	int size = 0;
+/**
+ * 클라이언트의 수신 버퍼 남은 공간에 바로 recv 한다.
+ * 힙 할당도, fd로 버퍼를 찾는 과정도 없다.
+ */
+int const Buffer::readMessage(Client& client) {
+	return client.getRecvBuf().readFrom(client.getClientFd());
+}
 
-	bufForSend[fd] += message;
-	if (bufForSend[fd] != "") {
-		std::string mes;
+ssize_t Buffer::flushQueue(SendQueue* queue, int fd) {
+	ssize_t sent;
+
+	if (queue->empty())
+		return 0;
+	sent = queue->flush(fd);
+	Stats::count(STAT_WRITE_CALLS);
+	if (sent > 0)
+		Stats::count(STAT_BYTES_OUT, sent);
+	if (sent != SYS_FAILURE && !queue->empty())
+		Stats::count(STAT_PARTIAL_WRITES);
+	FlightRecorder::record(TRACE_SEND, fd, sent, queue->size());
+	return sent;
+}
 
-		mes = bufForSend[fd];
-		size = send(fd, &mes[0], mes.size(), 0);
-		if (size == SYS_FAILURE)
-			return SYS_FAILURE;
-		bufForSend[fd] = "";
-		if (size < mes.size()) {
-			bufForSend[fd] = mes.substr(size, mes.size());
-		}
-	}
+// 쓰기 이벤트. 지난번에 다 못 보낸 내용을 writev로 보낸다
+int const Buffer::sendMessage(int fd) {
+	SendQueue* queue = findQueue(fd);
+
+	if (queue == NULL)
+		return 0;
+	return flushQueue(queue, fd);
+}
+
+int const Buffer::sendMessage(int fd, std::string const& message) {
+	Payload* payload = Payload::create(message);
+	int size = sendPayload(fd, payload);
+
+	payload->release();
 	return size;
 }
 
-std::string const Buffer::getReadBuf(int fd) {
-	if (bufForRead.find(fd) != bufForRead.end())
-		return bufForRead[fd];
-	return "";
+// reply::, error::가 만든 Payload를 그대로 넣는다
+int const Buffer::sendMessage(int fd, Reply const& reply) {
+	return sendPayload(fd, reply.get());
 }
 
-std::string const Buffer::getSendBuf(int fd) {
-	if (bufForSend.find(fd) != bufForSend.end())
-		return bufForSend[fd];
-	return "";
+/**
+ * 송신 큐에는 참조만 넣는다(복사 없음). 보내는 건 루프 끝의 flushPending.
+ * 다른 reactor가 맡은 클라이언트라면 주인 reactor에게 참조를 넘긴다.
+ */
+int const Buffer::sendPayload(int fd, Payload* payload) {
+	SendQueue* queue = findQueue(fd);
+
+	if (queue == NULL) {
+		Reactor::forward(fd, payload);
+		return 0;
+	}
+	// 한도를 넘겨서 버렸어도 루프 끝에 넘친 걸 알 수 있도록 목록에는 올린다
+	queue->push(payload);
+	if (!queue->isScheduled()) {
+		queue->setScheduled(true);
+		local->dirty.push_back(fd);
+	}
+	return 0;
 }
 
-void Buffer::setReadBuf(std::pair<int, std::string> val) {
-	if (bufForRead.find(val.first) != bufForRead.end())
-		bufForRead[val.first] += val.second;
-	else
-		bufForRead.insert(std::make_pair(val.first, val.second));
+/**
+ * 이번 루프에서 쌓인 fd마다 writev를 한 번씩 한다.
+ * 그 사이에 나간 클라이언트의 fd는 큐가 없으니 건너뛴다.
+ * 오류가 난 fd는 failed에, 소켓이 가득 차서 남은 게 있는 fd는 blocked에 담아서 reactor에게 넘긴다.
+ * 한도를 넘긴 fd는 보내지 않고 overflowed에 담는다(어차피 끊는다).
+ */
+void Buffer::flushPending(std::vector<int>& failed, std::vector<int>& blocked, std::vector<int>& overflowed) {
+	std::vector<int>& dirty = local->dirty;
+
+	for (size_t i = 0; i < dirty.size(); i++) {
+		SendQueue* queue = findQueue(dirty[i]);
+
+		if (queue == NULL || !queue->isScheduled())
+			continue ;
+		queue->setScheduled(false);
+		if (queue->isOverflowed())
+			overflowed.push_back(dirty[i]);
+		else if (flushQueue(queue, dirty[i]) == SYS_FAILURE)
+			failed.push_back(dirty[i]);
+		else if (!queue->empty())
+			blocked.push_back(dirty[i]);
+	}
+	dirty.clear();
 }
 
-void Buffer::setSendBuf(std::pair<int, std::string> val) {
-	if (bufForSend.find(val.first) != bufForSend.end())
-		bufForSend[val.first] += val.second;
-	else
-		bufForSend.insert(std::make_pair(val.first, val.second));
+bool Buffer::hasPending(int fd) {
+	SendQueue* queue = findQueue(fd);
+
+	return queue != NULL && !queue->empty();
 }
 
-void Buffer::resetReadBuf(int fd) {
-	if (bufForRead.find(fd) != bufForRead.end())
-		bufForRead[fd] = "";
-	else
-		bufForSend.insert(std::make_pair(fd, ""));
+size_t Buffer::getPending(int fd) {
+	SendQueue* queue = findQueue(fd);
+
+	return queue != NULL ? queue->size() : 0;
 }
 
-void Buffer::resetSendBuf(int fd) {
-	if (bufForSend.find(fd) != bufForSend.end())
-		bufForSend[fd] = "";
-	else
-		bufForSend.insert(std::make_pair(fd, ""));
+/**
+ * members 전원(except 제외)에게 같은 줄을 보낸다.
+ * 줄은 한 번만 만들어져 있고, 수신자마다 참조 카운트만 늘어난다.
+ */
+void Buffer::broadcast(cltvec const& members, Reply const& reply, Client const* except) {
+	for (size_t i = 0; i < members.size(); i++)
+		if (members[i] != except)
+			sendPayload(members[i]->getClientFd(), reply.get());
 }
 
-void Buffer::eraseReadBuf(int fd) {
-	if (bufForRead.find(fd) != bufForRead.end())
-		bufForRead.erase(fd);
+void Buffer::resetSendBuf(int fd, size_t limit) {
+	SendQueue* queue = findQueue(fd);
+
+	if (queue != NULL) {
+		queue->clear();
+		queue->setScheduled(false);
+	} else {
+		if (static_cast<size_t>(fd) >= local->queues.size())
+			local->queues.resize(fd + 1, NULL);
+		queue = local->queues[fd] = new SendQueue();
+	}
+	queue->setLimit(limit);
 }
 
 void Buffer::eraseSendBuf(int fd) {
-	if (bufForSend.find(fd) != bufForSend.end())
-		bufForSend.erase(fd);
+	SendQueue* queue = findQueue(fd);
+
+	if (queue != NULL) {
+		delete queue;
+		local->queues[fd] = NULL;
+	}
 }
@@ -5,44 +5,15 @@
 #include "../../include/utils/reply.hpp"
 #include "../../include/utils/Print.hpp"
 #include <sstream>
-
-int CommandExecute::getCommand() {
-	mesvec const& message = Message::getMessage();
-
-	if (!message.size())
-		return IS_NOT_ORDER;
-	if (message[0] == "PASS")
-		return IS_PASS;
-	if (message[0] == "NICK")
-		return IS_NICK;
-	if (message[0] == "USER")
-		return IS_USER;
-	if (message[0] == "PING")
-		return IS_PING;
-	if (message[0] == "PONG")
-		return IS_PONG;
-	if (message[0] == "MODE")
-		return IS_MODE;
-	if (message[0] == "JOIN")
-		return IS_JOIN;
-	if (message[0] == "QUIT")
-		return IS_QUIT;
-	// if (message[0] == "QUIT")
-	// 	return IS_QUIT;
-	// if (message[0] == "MODE")
-	// 	return IS_MODE;
-	return IS_NOT_ORDER;
-}
+#include <cstdio>
 
 void CommandExecute::motd(Client& client, std::string const& serverHost) {
 	Buffer::sendMessage(client.getClientFd(), reply::RPL_MOTDSTART(serverHost, client.getNick()));
-	Buffer::sendMessage(client.getClientFd(), reply::RPL_MOTD(serverHost, client.getNick(), "Hello! This is FT_IRC!"));
+	Buffer::sendMessage(client.getClientFd(), reply::RPL_MOTD(serverHost, client.getNick(), DEFAULT_MOTD));
 	Buffer::sendMessage(client.getClientFd(), reply::RPL_ENDOFMOTD(serverHost, client.getNick()));
 }
 
-void CommandExecute::pass(Client& client, std::string const& password, std::string const& serverHost) {
-	mesvec const& message = Message::getMessage();
-
+void CommandExecute::pass(Message const& message, Client& client, std::string const& password, std::string const& serverHost) {
 	if (message.size() != 2) {
 		Buffer::sendMessage(client.getClientFd(), error::ERR_NEEDMOREPARAMS(serverHost, "PASS"));
 	} else if (client.getPassConnect() & IS_PASS) {
@@ -54,23 +25,20 @@ void CommandExecute::pass(Client& client, std::string const& password, std::stri
 	}
 }
 
-static bool duplicate_nick(cltmap& clients, std::string const& nick) {
-	for (cltmap::iterator it = clients.begin(); it != clients.end(); it++) {
-		if (clients[it->first]->getNick() == nick)
-			return true;
-	}
-	return false;
-}
+// 자기 자신의 대소문자만 바꾸는 건(nick -> Nick) 충돌이 아니다
+static bool duplicate_nick(NickIndex const& nickIndex, Client const& client, std::string const& nick) {
+	Client* owner = nickIndex.find(nick);
 
-void CommandExecute::nick(Client& client, cltmap& clientList, std::string const& serverHost) {
-	mesvec const& message = Message::getMessage();
+	return owner != NULL && owner != &client;
+}
 
+void CommandExecute::nick(Message const& message, Client& client, NickIndex& nickIndex, std::string const& serverHost) {
 	// Nickname 충돌 오류는 어차피 서버 간 통신은 신경 쓰지 않아도 되기에 구현 안 함
 	if (message.size() != 2)
 		Buffer::sendMessage(client.getClientFd(), error::ERR_NONICKNAMEGIVEN(serverHost));
-	else if (duplicate_nick(clientList, message[1]))
+	else if (duplicate_nick(nickIndex, client, message[1]))
 		Buffer::sendMessage(client.getClientFd(), error::ERR_NICKNAMEINUSE(serverHost, message[1]));
-	else if (chkForbiddenChar(message[1], "#&:") || std::isdigit(message[1][0]))
+	else if (message[1].size > USERNICK_LEN || chkForbiddenChar(message[1], "#&:") || std::isdigit(message[1][0]))
 		Buffer::sendMessage(client.getClientFd(), error::ERR_ERRONEUSNICKNAME(serverHost, message[1]));
 	else {
 		client.setPassConnect(IS_NICK);
@@ -81,9 +49,7 @@ void CommandExecute::nick(Client& client, cltmap& clientList, std::string const&
 	}
 }
 
-void CommandExecute::user(Client& client, std::string const& serverHost, time_t const& serverStartTime) {
-	mesvec const& message = Message::getMessage();
-
+void CommandExecute::user(Message const& message, Client& client, RegisterBurst const& burst, std::string const& serverHost) {
 	if (message.size() != 5)
 		Buffer::sendMessage(client.getClientFd(), error::ERR_NEEDMOREPARAMS(serverHost, "USER"));
 	else if (client.getPassConnect() & IS_USER)
@@ -95,25 +61,14 @@ void CommandExecute::user(Client& client, std::string const& serverHost, time_t
 		client.setUser(message[1]);
 		client.setHost(message[2]);
 		client.setServ(message[3]);
-		if (message[4][0] == ':')
-			client.setReal(message[4].substr(1, message[4].size()));
-		else
-			client.setReal(message[4]);
-		if (client.getPassConnect() & IS_LOGIN) {
-			time_t serv_time = serverStartTime;
-			Buffer::sendMessage(client.getClientFd(), reply::RPL_WELCOME(serverHost, client.getNick(), client.getUser(), client.getHost()));
-			Buffer::sendMessage(client.getClientFd(), reply::RPL_YOURHOST(serverHost, client.getNick(), "1.0"));
-			Buffer::sendMessage(client.getClientFd(), reply::RPL_CREATED(serverHost, client.getNick(), getStringTime(serv_time)));
-			Buffer::sendMessage(client.getClientFd(), reply::RPL_MYINFO(serverHost, client.getNick(), "ircserv 1.0", "x", "itkol"));
-			Buffer::sendMessage(client.getClientFd(), reply::RPL_ISUPPORT(serverHost, client.getNick()));
-			CommandExecute::motd(client, serverHost);
-		}
+		client.setReal(message[4]);
+		// 001~005와 MOTD는 미리 만든 틀에 별칭, 사용자 이름, 호스트만 끼워서 한 번에 보낸다
+		if (client.getPassConnect() & IS_LOGIN)
+			Buffer::sendMessage(client.getClientFd(), burst.render(client.getNick(), client.getUser(), client.getHost()));
 	}
 }
 
-void CommandExecute::ping(Client& client, std::string const& serverHost) {
-	mesvec const& message = Message::getMessage();
-
+void CommandExecute::ping(Message const& message, Client& client, std::string const& serverHost) {
 	client.setFinalTime();
 	if (message.size() != 2)
 		error::ERR_NEEDMOREPARAMS(serverHost, message[0]);
@@ -124,7 +79,7 @@ void CommandExecute::ping(Client& client, std::string const& serverHost) {
 }
 
 void CommandExecute::pong(Client& client, std::string const& serverHost) {
-	Buffer::sendMessage(client.getClientFd(), ":" + serverHost + " PONG " + serverHost + " :" + serverHost);
+	Buffer::sendMessage(client.getClientFd(), reply::RPL_PONG(serverHost));
 }
 
 static bool chkNum(std::string const& str) {
@@ -169,8 +124,7 @@ static void createSetMode(int mode, Channel& chan, std::string& outputMode, std:
 	}
 }
 
-void CommandExecute::mode(Client& client, chlmap& channel, std::string const& serverHost) {
-	mesvec const& message = Message::getMessage();
+void CommandExecute::mode(Message const& message, Client& client, chlmap& channel, std::string const& serverHost) {
 	chlmap::iterator it;
 	std::string successMode = "";
 	std::string successValue = "";
@@ -190,10 +144,10 @@ void CommandExecute::mode(Client& client, chlmap& channel, std::string const& se
 		Buffer::sendMessage(client.getClientFd(), error::ERR_NEEDMOREPARAMS(serverHost, "MODE"));
 	else if ((it = channel.find(message[1])) == channel.end())
 		Buffer::sendMessage(client.getClientFd(), error::ERR_NOSUCHCHANNEL(serverHost, client.getNick(), message[1]));
-	else if (channel[message[1]]->getChanOp().getClientFd() != client.getClientFd())
+	else if (!it->second->isChanOp(&client))
 		Buffer::sendMessage(client.getClientFd(), error::ERR_CHANOPRIVSNEEDED(serverHost, client.getNick(), message[1]));
 	else {
-		for (int i = 0; i < message[2].size(); i++) {
+		for (int i = 0; i < message[2].size; i++) {
 			if (message[2][i] == '+' || message[2][i] == '-') {
 				if (message[2][i] == '+') {
 					successMode += "+";
@@ -211,14 +165,14 @@ void CommandExecute::mode(Client& client, chlmap& channel, std::string const& se
 			if (supportMode.find(message[2][i]) != std::string::npos) {
 				switch (message[2][i]) {
 					case 'l':
-						if (val > message.size()
+						if (val >= message.size()
 							|| !chkNum(message[val]))
 							Buffer::sendMessage(client.getClientFd(),
 								error::ERR_INVALIDMODEPARAM(serverHost, client.getNick(), message[1], message[2][i], "You must specify a parameter. Syntax: <limit>"));
 						else {
 							it->second->setMode(set[0], flag);
 							successMode += "l";
-							successValue += message[val] + " ";
+							successValue += message[val].str() + " ";
 						}
 						val++;
 						break;
@@ -227,14 +181,14 @@ void CommandExecute::mode(Client& client, chlmap& channel, std::string const& se
 						successMode += "i";
 						break;
 					case 'k':
-						if (val > message.size()
+						if (val >= message.size()
 							|| message[val] == "")
 							Buffer::sendMessage(client.getClientFd(),
 								error::ERR_INVALIDMODEPARAM(serverHost, client.getNick(), message[1], message[2][i], "You must specify a parameter. Syntax: <key>"));
 						else {
 							it->second->setMode(set[2], flag);
 							successMode += "k";
-							successValue += message[val] + " ";
+							successValue += message[val].str() + " ";
 						}
 						val++;
 						break;
@@ -242,7 +196,7 @@ void CommandExecute::mode(Client& client, chlmap& channel, std::string const& se
 						it->second->setMode(set[3], flag);
 						break;
 					case 'o':
-						if (val > message.size()
+						if (val >= message.size()
 							|| message[val] == "")
 							Buffer::sendMessage(client.getClientFd(),
 								error::ERR_INVALIDMODEPARAM(serverHost, client.getNick(), message[1], message[2][i], "You must specify a parameter. Syntax: <nick>"));
@@ -259,11 +213,9 @@ void CommandExecute::mode(Client& client, chlmap& channel, std::string const& se
 		}
 	}
 	if (successMode != "") {
-		cltmap const& userList = it->second->getUserList();
 		if (successValue != "" && successValue[successValue.size() - 1] == ' ')
 			successValue = successValue.substr(0, successValue.size() - 1);
-		for (cltmap::const_iterator iter = userList.begin(); iter != userList.end(); iter++)
-			Buffer::sendMessage(iter->second->getClientFd(), reply::RPL_SUCCESSMODE(client.getNick(), client.getUser(), client.getHost(), message[1], successMode, successValue));
+		Buffer::broadcast(it->second->getMembers(), reply::RPL_SUCCESSMODE(client.getNick(), client.getUser(), client.getHost(), message[1], successMode, successValue), NULL);
 	}
 }
 
@@ -275,6 +227,15 @@ static bool isChanName(std::string const& chanName) {
 	return false;
 }
 
+// 캐시해둔 조각마다 353 한 줄씩. 어느 줄도 512바이트를 넘지 않는다
+static void sendNames(Client& client, Channel const& channel, std::string const& serverHost) {
+	std::vector<std::string> const& names = channel.getNames();
+
+	for (size_t i = 0; i < names.size(); i++)
+		if (!names[i].empty())
+			Buffer::sendMessage(client.getClientFd(), reply::RPL_NAMREPLY(serverHost, client.getNick(), channel.getChName(), names[i]));
+}
+
 static void addChannel(std::string& chName, Client* client, chlmap& chlList) {
 	Channel* channel = new Channel(chName, client);
 
@@ -288,12 +249,71 @@ static void delChannel(std::string& chName, chlmap& chlList) {
 	}
 }
 
-void CommandExecute::join(Client& client, chlmap& chlList, std::string const& serverHost) {
+/**
+ * OPER <name> <password>. 서버를 띄울 때 -o로 준 이름, 비밀번호와 맞으면 운영자가 된다(381)
+ * -o 없이 띄웠으면 아무도 운영자가 될 수 없다(491)
+ */
+void CommandExecute::oper(Message const& message, Client& client, std::string const& opName, std::string const& opPassword, std::string const& serverHost) {
+	int fd = client.getClientFd();
+
+	if (opName.empty()) {
+		Buffer::sendMessage(fd, error::ERR_NOOPERHOST(serverHost, client.getNick()));
+	} else if (message[1] != opName || message[2] != opPassword) {
+		Buffer::sendMessage(fd, error::ERR_PASSWDMISMATCH(serverHost));
+	} else {
+		client.setOperator(true);
+		Buffer::sendMessage(fd, reply::RPL_YOUREOPER(serverHost, client.getNick()));
+	}
+}
+
+/**
+ * STATS <query>. 운영자(OPER)만 볼 수 있다. 아니면 481
+ * m : 명령어마다 호출 수와 받은 바이트(212), 이어서 명령어별 실행 시간 분포(249)
+ * e : 이벤트 종류별 수, I/O 호출 수와 바이트, 큐 깊이(249)
+ * u : 가동 시간(242)
+ * 어느 경우든 219로 끝난다. snapshot은 모든 reactor의 것을 합친 것이다
+ */
+void CommandExecute::stats(Message const& message, Client& client, Stats const& snapshot, time_t startTime, std::string const& serverHost) {
+	int fd = client.getClientFd();
+	std::string query = message.size() > 1 ? message[1].str().substr(0, 1) : "*";
+	std::vector<std::string> lines;
+
+	if (!client.IsOperator()) {
+		Buffer::sendMessage(fd, error::ERR_NOPRIVILEGES(serverHost, client.getNick()));
+		return ;
+	}
+	if (query == "m") {
+		for (size_t i = 0; i < snapshot.getEntryCount(); i++) {
+			CommandStats const& command = snapshot.getCommand(i);
+			std::ostringstream calls;
+			std::ostringstream bytes;
+
+			if (command.calls == 0)
+				continue ;
+			calls << command.calls;
+			bytes << command.bytes;
+			Buffer::sendMessage(fd, reply::RPL_STATSCOMMANDS(serverHost, client.getNick(), snapshot.getEntry(i).name, calls.str(), bytes.str()));
+		}
+	} else if (query == "u") {
+		time_t up = getCurTime() - startTime;
+		char uptime[64];
+
+		snprintf(uptime, sizeof(uptime), "%ld days %ld:%02ld:%02ld", static_cast<long>(up / 86400),
+			static_cast<long>(up / 3600 % 24), static_cast<long>(up / 60 % 60), static_cast<long>(up % 60));
+		Buffer::sendMessage(fd, reply::RPL_STATSUPTIME(serverHost, client.getNick(), uptime));
+	}
+	if (query.size() == 1)
+		snapshot.describe(query[0], lines);
+	for (size_t i = 0; i < lines.size(); i++)
+		Buffer::sendMessage(fd, reply::RPL_STATSDEBUG(serverHost, client.getNick(), lines[i]));
+	Buffer::sendMessage(fd, reply::RPL_ENDOFSTATS(serverHost, client.getNick(), query));
+}
+
+void CommandExecute::join(Message const& message, Client& client, chlmap& chlList, std::string const& serverHost) {
 	std::istringstream chan;
 	std::istringstream key;
 	std::string chanStr = "";
 	std::string keyStr = "";
-	mesvec const& message = Message::getMessage();
 	Channel* channel;
 
 	if (message.size() < 2 || message.size() > 3)
@@ -329,11 +349,9 @@ void CommandExecute::join(Client& client, chlmap& chlList, std::string const& se
 					Buffer::sendMessage(client.getClientFd(), reply::RPL_SUCCESSJOIN(client.getNick(), client.getUser(), client.getHost(), chanStr));
 					if (channel->getTopic() != "")
 						Buffer::sendMessage(client.getClientFd(), reply::RPL_TOPIC(serverHost, client.getNick(), chanStr, channel->getTopic()));
-					Buffer::sendMessage(client.getClientFd(), reply::RPL_NAMREPLY(serverHost, client.getNick(), chanStr, channel->getStrUserList()));
+					sendNames(client, *channel, serverHost);
 					Buffer::sendMessage(client.getClientFd(), reply::RPL_ENDOFNAMES(serverHost, client.getNick(), chanStr));
-					for (cltmap::const_iterator iter = channel->getUserList().begin(); iter != channel->getUserList().end(); iter++)
-						if (iter->second != &client)
-							Buffer::sendMessage(iter->second->getClientFd(), reply::RPL_SUCCESSJOIN(client.getNick(), client.getUser(), client.getHost(), chanStr));
+					Buffer::broadcast(channel->getMembers(), reply::RPL_SUCCESSJOIN(client.getNick(), client.getUser(), client.getHost(), chanStr), &client);
 					break;
 			}
 			chanStr = "";
@@ -342,15 +360,80 @@ void CommandExecute::join(Client& client, chlmap& chlList, std::string const& se
 	}
 }
 
-void CommandExecute::quit(Client& client, cltmap& clientList) {
-	mesvec const& message = Message::getMessage();
+void CommandExecute::quit(Message const& message, Client& client, cltmap& clientList) {
 	std::string reason = "";
 
 	for (int i = 1; i < message.size(); i++)
-		reason += message[i] + " ";
+		reason += message[i].str() + " ";
 	if (reason != "" && reason[reason.size() - 1] == ' ')
 		reason = reason.substr(0, reason.size() - 1);
 	for (cltmap::iterator it = clientList.begin(); it != clientList.end(); it++)
 		if (it->second != &client)
 			Buffer::sendMessage(client.getClientFd(), reply::RPL_SUCCESSQUIT(client.getNick(), client.getUser(), client.getHost(), reason));
 }
+
+/**
+ * PRIVMSG, NOTICE 공용 전달부
+ * 1. 대상은 쉼표로 여러 개 줄 수 있다. 채널이면 채널에, 아니면 별칭 색인에서 찾은 클라이언트에게 보낸다
+ * 2. 채널에는 보낸 사람이 가입자일 때만 보낼 수 있다(외부 메세지 금지)
+ * 3. 보낼 줄은 대상마다 한 번만 만들고, 채널 가입자 배열을 훑으며 보낸 사람을 뺀 모두에게 참조만 넣는다
+ * 4. NOTICE는 자동 응답끼리 끝없이 주고받지 않도록 어떤 오류 응답도 돌려주지 않는다(RFC 1459 4.4.2)
+ */
+static void deliver(Message const& message, Client& client, chlmap& chlList, NickIndex& nickIndex, std::string const& serverHost, bool notice) {
+	std::string command = notice ? "NOTICE" : "PRIVMSG";
+	StrView targets = message[1];
+	size_t start = 0;
+
+	if (message.size() < 2) {
+		if (!notice)
+			Buffer::sendMessage(client.getClientFd(), error::ERR_NORECIPIENT(serverHost, client.getNick(), command));
+		return ;
+	}
+	if (message.size() < 3 || message[2].empty()) {
+		if (!notice)
+			Buffer::sendMessage(client.getClientFd(), error::ERR_NOTEXTTOSEND(serverHost, client.getNick()));
+		return ;
+	}
+	for (size_t i = 0; i <= targets.size; i++) {
+		if (i < targets.size && targets.data[i] != ',')
+			continue ;
+
+		std::string target(targets.data + start, i - start);
+
+		start = i + 1;
+		if (target.empty())
+			continue ;
+		if (isChanName(target)) {
+			chlmap::iterator it = chlList.find(target);
+
+			if (it == chlList.end()) {
+				if (!notice)
+					Buffer::sendMessage(client.getClientFd(), error::ERR_NOSUCHNICK(serverHost, client.getNick(), target));
+				continue ;
+			}
+			if (!it->second->isMember(&client)) {
+				if (!notice)
+					Buffer::sendMessage(client.getClientFd(), error::ERR_CANNOTSENDTOCHAN(serverHost, client.getNick(), target));
+				continue ;
+			}
+			Buffer::broadcast(it->second->getMembers(), reply::RPL_PRIVMSG(client.getNick(), client.getUser(), client.getHost(), command, target, message[2]), &client);
+		} else {
+			Client* recipient = nickIndex.find(target);
+
+			if (recipient == NULL) {
+				if (!notice)
+					Buffer::sendMessage(client.getClientFd(), error::ERR_NOSUCHNICK(serverHost, client.getNick(), target));
+				continue ;
+			}
+			Buffer::sendMessage(recipient->getClientFd(), reply::RPL_PRIVMSG(client.getNick(), client.getUser(), client.getHost(), command, recipient->getNick(), message[2]));
+		}
+	}
+}
+
+void CommandExecute::privmsg(Message const& message, Client& client, chlmap& chlList, NickIndex& nickIndex, std::string const& serverHost) {
+	deliver(message, client, chlList, nickIndex, serverHost, false);
+}
+
+void CommandExecute::notice(Message const& message, Client& client, chlmap& chlList, NickIndex& nickIndex, std::string const& serverHost) {
+	deliver(message, client, chlList, nickIndex, serverHost, true);
+}
@@ -0,0 +1,49 @@
+#include "../../include/utils/CommandTable.hpp"
+#include <cctype>
+#include <cstring>
+#include <strings.h>
+#include <stdexcept>
+
+# define MAX_SEED 100000 // 이만큼 찾아도 안 되면 테이블 크기를 키워야 한다
+
+CommandTable::CommandTable(CommandEntry const* entries, size_t count) : seed(0) {
+	for (unsigned int seed = 1; seed < MAX_SEED; seed++) {
+		this->seed = seed;
+		if (this->build(entries, count))
+			return ;
+	}
+	throw std::runtime_error("Error : no perfect hash for command table");
+}
+
+// seed를 섞은 FNV-1a. 대문자로 바꿔서 해시하므로 대소문자가 달라도 같은 칸에 간다
+unsigned int CommandTable::hash(unsigned int seed, char const* name, size_t size) {
+	unsigned int h = 2166136261u ^ seed;
+
+	for (size_t i = 0; i < size; i++) {
+		h ^= static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(name[i])));
+		h *= 16777619u;
+	}
+	return h ^ (h >> 15);
+}
+
+// 현재 seed로 모든 명령어를 칸에 넣어본다. 한 칸이라도 부딪히면 실패
+bool CommandTable::build(CommandEntry const* entries, size_t count) {
+	for (size_t i = 0; i < COMMAND_TABLE_SIZE; i++)
+		this->slots[i] = NULL;
+	for (size_t i = 0; i < count; i++) {
+		unsigned int slot = hash(this->seed, entries[i].name, strlen(entries[i].name)) & (COMMAND_TABLE_SIZE - 1);
+
+		if (this->slots[slot] != NULL)
+			return false;
+		this->slots[slot] = &entries[i];
+	}
+	return true;
+}
+
+CommandEntry const* CommandTable::find(StrView const& token) const {
+	CommandEntry const* entry = this->slots[hash(this->seed, token.data, token.size) & (COMMAND_TABLE_SIZE - 1)];
+
+	if (entry == NULL || strncasecmp(entry->name, token.data, token.size) != 0 || entry->name[token.size] != 0)
+		return NULL;
+	return entry;
+}
@@ -0,0 +1,43 @@
+#include "../../include/utils/ConnClass.hpp"
+#include <cstdlib>
+
+/**
+ * 접속 등급표. 주소와 마스크는 호스트 바이트 순서.
+ * trusted : 믿을 수 있는 봇, 브리지 등. 한 번에 많이 받아가는 경우가 많아서 넉넉하게 주고, 흐름 제어도 하지 않는다
+ *           기본으로는 아무 주소에도 맞지 않는다. -x로 네트워크를 줬을 때만 쓴다(trust)
+ * users : 나머지 전부(loopback 포함). 토큰 20개로 시작해서 초당 4개씩(PRIVMSG 기준 몰아서 20줄, 이후 초당 4줄)
+ */
+static ConnClass classes[] = {
+	{ "trusted", 0, 0, 256 * 1024, 2 * 1024 * 1024, 64, 16 * 1024, 0, 0 },
+	{ "users", 0, 0, 64 * 1024, 512 * 1024, 16, 4 * 1024, 20, 4 },
+};
+
+static bool trusted = false;
+
+ConnClass const& ConnClass::classify(in_addr addr) {
+	in_addr_t host = ntohl(addr.s_addr);
+	size_t count = sizeof(classes) / sizeof(classes[0]);
+
+	for (size_t i = trusted ? 0 : 1; i < count - 1; i++)
+		if ((host & classes[i].mask) == classes[i].network)
+			return classes[i];
+	return classes[count - 1];
+}
+
+// "주소/비트 수" 꼴만 받는다(예 : 127.0.0.0/8)
+bool ConnClass::trust(std::string const& cidr) {
+	size_t slash = cidr.find('/');
+	in_addr addr;
+	char* end;
+	long bits;
+
+	if (slash == std::string::npos || inet_pton(AF_INET, cidr.substr(0, slash).c_str(), &addr) != 1)
+		return false;
+	bits = std::strtol(cidr.c_str() + slash + 1, &end, 10);
+	if (*end != '\0' || end == cidr.c_str() + slash + 1 || bits < 0 || bits > 32)
+		return false;
+	classes[0].mask = bits == 0 ? 0 : 0xFFFFFFFFU << (32 - bits);
+	classes[0].network = ntohl(addr.s_addr) & classes[0].mask;
+	trusted = true;
+	return true;
+}
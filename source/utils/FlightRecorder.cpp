@@ -0,0 +1,199 @@
+#include "../../include/utils/FlightRecorder.hpp"
+#include "../../include/utils/Logger.hpp"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+char* FlightRecorder::base = NULL;
+size_t FlightRecorder::length = 0;
+std::string FlightRecorder::path;
+unsigned long FlightRecorder::slow = 0;
+volatile time_t FlightRecorder::lastDump = 0;
+volatile sig_atomic_t FlightRecorder::dumpRequested = 0;
+pthread_t FlightRecorder::thread;
+volatile bool FlightRecorder::running = false;
+volatile int FlightRecorder::pending = 0;
+
+THREAD_LOCAL TraceRingHeader* FlightRecorder::ring = NULL;
+THREAD_LOCAL TraceRecord* FlightRecorder::records = NULL;
+THREAD_LOCAL int FlightRecorder::reactor = 0;
+
+static uint64_t clockNow(clockid_t id) {
+	struct timespec ts;
+
+	clock_gettime(id, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * 파일 크기를 먼저 잡고(ftruncate) mmap 한다. 새로 잡은 부분은 0이라 원형 버퍼의 head도 0에서 시작한다.
+ * 명령어 이름은 테이블 순서대로 머리에 적어둔다. 기록에는 번호만 남긴다.
+ */
+void FlightRecorder::start(std::string const& path, int reactorCount, unsigned long slow, CommandEntry const* entries, size_t entryCount) {
+	TraceHeader* header;
+	int fd;
+	void* map;
+
+	FlightRecorder::length = TRACE_HEADER_SIZE + reactorCount * TRACE_RING_SIZE(TRACE_RING_RECORDS);
+	if ((fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)) == SYS_FAILURE)
+		throw std::runtime_error("Error : cannot open trace file " + path);
+	if (ftruncate(fd, FlightRecorder::length) == SYS_FAILURE) {
+		close(fd);
+		throw std::runtime_error("Error : cannot size trace file " + path);
+	}
+	map = mmap(NULL, FlightRecorder::length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		throw std::runtime_error("Error : cannot map trace file " + path);
+
+	header = static_cast<TraceHeader*>(map);
+	memcpy(header->magic, TRACE_MAGIC, sizeof(header->magic));
+	header->version = TRACE_VERSION;
+	header->reactorCount = reactorCount;
+	header->ringRecords = TRACE_RING_RECORDS;
+	header->commandCount = entryCount < TRACE_MAX_COMMANDS ? entryCount : TRACE_MAX_COMMANDS;
+	header->monoStart = clockNow(CLOCK_MONOTONIC);
+	header->wallStart = clockNow(CLOCK_REALTIME);
+	for (size_t i = 0; i < header->commandCount; i++)
+		strncpy(header->commands[i], entries[i].name, TRACE_NAME_LEN - 1);
+
+	FlightRecorder::base = static_cast<char*>(map);
+	FlightRecorder::path = path;
+	FlightRecorder::slow = slow * 1000;
+	FlightRecorder::running = true;
+	if (pthread_create(&FlightRecorder::thread, NULL, &FlightRecorder::threadMain, NULL) != 0) {
+		FlightRecorder::running = false;
+		throw std::runtime_error("Error : pthread_create");
+	}
+}
+
+// 덤프 스레드를 먼저 멈추고(남은 예약은 쓰고 끝난다) 매핑을 푼다
+void FlightRecorder::stop() {
+	if (FlightRecorder::base == NULL)
+		return ;
+	if (FlightRecorder::running) {
+		FlightRecorder::running = false;
+		pthread_join(FlightRecorder::thread, NULL);
+	}
+	munmap(FlightRecorder::base, FlightRecorder::length);
+	FlightRecorder::base = NULL;
+	ring = NULL;
+}
+
+void FlightRecorder::bind(int reactorId) {
+	TraceRingHeader* header;
+
+	if (FlightRecorder::base == NULL || reactorId >= static_cast<int>(reinterpret_cast<TraceHeader*>(base)->reactorCount))
+		return ;
+	header = reinterpret_cast<TraceRingHeader*>(base + TRACE_HEADER_SIZE + reactorId * TRACE_RING_SIZE(TRACE_RING_RECORDS));
+	ring = header;
+	records = reinterpret_cast<TraceRecord*>(header + 1);
+	reactor = reactorId;
+}
+
+bool FlightRecorder::isActive() {
+	return ring != NULL;
+}
+
+unsigned long FlightRecorder::now() {
+	return clockNow(CLOCK_MONOTONIC);
+}
+
+// 칸을 다 채운 뒤에 head를 늘린다. 풀어보는 쪽은 head 앞까지만 믿는다
+void FlightRecorder::record(TraceEvent type, int fd, uint32_t value, uint32_t aux, uint16_t extra) {
+	TraceRecord* slot;
+	uint64_t head;
+
+	if (ring == NULL)
+		return ;
+	head = ring->head;
+	slot = &records[head & (TRACE_RING_RECORDS - 1)];
+	slot->time = clockNow(CLOCK_MONOTONIC);
+	slot->value = value;
+	slot->aux = aux;
+	slot->fd = fd;
+	slot->extra = extra;
+	slot->type = type;
+	slot->reactor = reactor;
+	__sync_synchronize();
+	ring->head = head + 1;
+}
+
+void FlightRecorder::endLoop(unsigned long start, int cntEvents) {
+	unsigned long busy;
+
+	if (ring == NULL)
+		return ;
+	busy = now() - start;
+	record(TRACE_LOOP, -1, busy < TRACE_FAILED ? busy : TRACE_FAILED, cntEvents > 0 ? cntEvents : 0);
+	if (slow != 0 && busy >= slow)
+		dump(1);
+}
+
+// 여러 reactor가 동시에 요청해도 CAS로 한 번만 예약한다. 시스템 콜 없이 돌아온다
+void FlightRecorder::dump(uint16_t reason) {
+	time_t cur = getCachedTime();
+	time_t last = FlightRecorder::lastDump;
+
+	if (base == NULL || cur - last < TRACE_DUMP_INTERVAL || !__sync_bool_compare_and_swap(&FlightRecorder::lastDump, last, cur))
+		return ;
+	record(TRACE_DUMP, -1, 0, 0, reason);
+	__sync_lock_test_and_set(&FlightRecorder::pending, reason + 1);
+}
+
+void* FlightRecorder::threadMain(void* arg) {
+	int reason;
+
+	(void)arg;
+	while (true) {
+		bool last = !FlightRecorder::running;
+
+		if ((reason = __sync_lock_test_and_set(&FlightRecorder::pending, 0)) != 0)
+			writeDump(reason - 1);
+		if (last)
+			break ;
+		usleep(TRACE_DUMP_POLL);
+	}
+	return NULL;
+}
+
+/**
+ * 덤프 스레드에서만 부른다.
+ * reactor들은 그동안에도 계속 쓰므로, 덤프 중에 덮어쓴 몇 칸은 어긋날 수 있다(풀어보는 쪽에서 거른다).
+ */
+void FlightRecorder::writeDump(uint16_t reason) {
+	time_t cur = updateCachedTime(); // 로그 시각도 이 스레드의 캐시를 쓴다
+	struct tm tm;
+	char stamp[32];
+	std::string target;
+	size_t written = 0;
+	ssize_t n;
+	int fd;
+
+	localtime_r(&cur, &tm);
+	strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+	target = FlightRecorder::path + "." + stamp;
+	if ((fd = open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) == SYS_FAILURE) {
+		Logger::log(LOG_WARN, YELLOW, "trace dump failed : %s", target.c_str());
+		return ;
+	}
+	while (written < length && (n = write(fd, base + written, length - written)) > 0)
+		written += n;
+	close(fd);
+	Logger::log(LOG_WARN, YELLOW, "trace dumped (%s) : %s", reason ? "slow loop" : "signal", target.c_str());
+}
+
+void FlightRecorder::requestDump() {
+	dumpRequested = 1;
+}
+
+bool FlightRecorder::takeDumpRequest() {
+	if (!dumpRequested)
+		return false;
+	dumpRequested = 0;
+	return true;
+}
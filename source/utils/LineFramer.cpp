@@ -0,0 +1,59 @@
+#include "../../include/utils/LineFramer.hpp"
+#include "../../include/utils/utils.hpp"
+
+LineFramer::LineFramer() : scanned(0), discarding(false) {
+}
+
+/**
+ * 줄 끝은 CRLF, CR, LF 중 먼저 나오는 것으로 본다.
+ * 줄을 돌려줄 때는 이미 consume 했으므로 호출한 쪽은 consume 하지 않는다.
+ * consume은 head만 옮기므로 다음 recv 전까지 line이 가리키는 내용은 그대로 남아 있다.
+ */
+int LineFramer::next(RecvBuffer& buf, StrView& line) {
+	while (true) {
+		char const* begin = buf.begin();
+		size_t size = buf.size();
+		size_t cut = this->scanned;
+		size_t terminator;
+
+		while (cut < size && begin[cut] != CR && begin[cut] != LF)
+			cut++;
+
+		// 종결자가 없으면 어디까지 봤는지만 기억한다. 이미 제한을 넘겼다면 바로 버린다
+		if (cut == size) {
+			if (this->discarding || size > MESSAGE_LEN - 2) {
+				bool reported = this->discarding;
+
+				buf.consume(size);
+				this->scanned = 0;
+				this->discarding = true;
+				return reported ? FRAME_NONE : FRAME_TOOLONG;
+			}
+			this->scanned = size;
+			return FRAME_NONE;
+		}
+
+		terminator = (begin[cut] == CR && cut + 1 < size && begin[cut + 1] == LF) ? 2 : 1;
+		buf.consume(cut + terminator);
+		this->scanned = 0;
+
+		// 버리던 줄의 끝, 빈 줄(혹은 CR과 LF가 나뉘어 도착한 LF)은 건너뛴다
+		if (this->discarding) {
+			this->discarding = false;
+			continue;
+		}
+		if (cut == 0)
+			continue;
+		if (cut > MESSAGE_LEN - 2)
+			return FRAME_TOOLONG;
+
+		line.data = begin;
+		line.size = cut;
+		return FRAME_LINE;
+	}
+}
+
+void LineFramer::reset() {
+	this->scanned = 0;
+	this->discarding = false;
+}
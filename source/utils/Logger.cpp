@@ -0,0 +1,184 @@
+#include "../../include/utils/Logger.hpp"
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <unistd.h>
+
+# define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+/**
+ * 칸의 seq는 몇 바퀴째(lap) 칸인지와 상태를 함께 담는다.
+ * 2 * lap이면 비어서 lap번째 바퀴의 기록을 기다리는 중, 2 * lap + 1이면 채워져서 읽기를 기다리는 중이다.
+ * 처음에는 전부 0(0번째 바퀴, 비었음)이라 따로 초기화하지 않는다.
+ */
+Logger::Record Logger::ring[LOG_RING_SIZE];
+volatile unsigned long Logger::head = 0;
+unsigned long Logger::tail = 0;
+volatile unsigned long Logger::dropped = 0;
+volatile unsigned long Logger::suppressed = 0;
+Logger::Window Logger::windows[LOG_LEVELS];
+
+int Logger::fd = STDERR_FILENO;
+bool Logger::color = false;
+LogLevel Logger::threshold = LOG_INFO;
+volatile bool Logger::running = false;
+pthread_t Logger::thread;
+
+static char const* levelName[LOG_LEVELS] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+static unsigned long emptyTurn(unsigned long pos) {
+	return (pos / LOG_RING_SIZE) * 2;
+}
+
+void Logger::start(int fd, LogLevel threshold) {
+	Logger::fd = fd;
+	Logger::color = isatty(fd);
+	Logger::threshold = threshold;
+	Logger::running = true;
+	if (pthread_create(&Logger::thread, NULL, &Logger::threadMain, NULL) != 0)
+		throw std::runtime_error("Error : pthread_create");
+}
+
+void Logger::stop() {
+	if (!Logger::running)
+		return ;
+	Logger::running = false;
+	pthread_join(Logger::thread, NULL);
+	drain();
+}
+
+bool Logger::isEnabled(LogLevel level) {
+	return level >= Logger::threshold;
+}
+
+/**
+ * 1. 레벨과 초당 상한을 먼저 확인한다(상한은 초가 바뀔 때 먼저 본 스레드가 되돌린다. 경계에서 몇 개 더 받아도 괜찮다)
+ * 2. head를 CAS로 하나 늘려서 칸을 잡는다. 칸이 아직 읽히지 않았으면 가득 찬 것이니 버린다
+ * 3. 칸에 바로 vsnprintf로 쓰고, seq를 채워짐으로 바꿔서 기록 스레드에 넘긴다
+ */
+void Logger::log(LogLevel level, Color color, char const* format, ...) {
+	Window& window = Logger::windows[level];
+	time_t now = getCachedTime();
+	unsigned long pos;
+	Record* record;
+	va_list args;
+	int len;
+
+	if (!isEnabled(level))
+		return ;
+	if (window.second != now) {
+		window.second = now;
+		window.count = 0;
+	}
+	if (__sync_add_and_fetch(&window.count, 1) > LOG_RATE_PER_SEC) {
+		__sync_add_and_fetch(&Logger::suppressed, 1);
+		return ;
+	}
+
+	pos = Logger::head;
+	while (true) {
+		record = &Logger::ring[pos & LOG_RING_MASK];
+		long diff = static_cast<long>(record->seq - emptyTurn(pos));
+
+		if (diff == 0) {
+			if (__sync_bool_compare_and_swap(&Logger::head, pos, pos + 1))
+				break ;
+			pos = Logger::head;
+		} else if (diff < 0) {
+			__sync_add_and_fetch(&Logger::dropped, 1);
+			return ;
+		} else
+			pos = Logger::head;
+	}
+
+	va_start(args, format);
+	len = vsnprintf(record->text, LOG_RECORD_LEN, format, args);
+	va_end(args);
+	record->len = len < 0 ? 0 : (len >= LOG_RECORD_LEN ? LOG_RECORD_LEN - 1 : len);
+	record->level = level;
+	record->color = color;
+	record->time = now;
+	__sync_synchronize();
+	record->seq = emptyTurn(pos) + 1;
+}
+
+void* Logger::threadMain(void* arg) {
+	(void)arg;
+	while (Logger::running) {
+		drain();
+		usleep(LOG_FLUSH_INTERVAL);
+	}
+	return NULL;
+}
+
+static void writeAll(int fd, char const* data, size_t size) {
+	while (size > 0) {
+		ssize_t n = write(fd, data, size);
+
+		if (n == SYS_FAILURE && errno == EINTR)
+			continue ;
+		if (n <= 0)
+			return ;
+		data += n;
+		size -= n;
+	}
+}
+
+/**
+ * 채워진 칸을 차례대로 꺼내서 batch에 모으고, 가득 차거나 다 꺼냈을 때 한 번에 쓴다.
+ * 기록 스레드 하나만 부른다(stop()은 스레드가 끝난 뒤에 부른다).
+ */
+void Logger::drain() {
+	static char batch[LOG_BATCH_LEN];
+	static time_t stampSecond = 0;
+	static char stamp[64];
+	size_t used = 0;
+	unsigned long lost;
+
+	while (true) {
+		Record& record = Logger::ring[Logger::tail & LOG_RING_MASK];
+		struct tm tm;
+
+		if (record.seq != emptyTurn(Logger::tail) + 1)
+			break ;
+		__sync_synchronize();
+		if (record.time != stampSecond) {
+			stampSecond = record.time;
+			localtime_r(&stampSecond, &tm);
+			strftime(stamp, sizeof(stamp), "%c", &tm);
+		}
+		if (used + LOG_RECORD_LEN + sizeof(stamp) + 32 > LOG_BATCH_LEN) {
+			writeAll(Logger::fd, batch, used);
+			used = 0;
+		}
+		if (Logger::color)
+			used += snprintf(batch + used, LOG_BATCH_LEN - used, "\x1b[%dm[%s] %s %.*s\x1b[%dm\n", record.color, stamp, levelName[record.level], static_cast<int>(record.len), record.text, RESET);
+		else
+			used += snprintf(batch + used, LOG_BATCH_LEN - used, "[%s] %s %.*s\n", stamp, levelName[record.level], static_cast<int>(record.len), record.text);
+		__sync_synchronize();
+		record.seq = emptyTurn(Logger::tail + LOG_RING_SIZE);
+		Logger::tail++;
+	}
+
+	// 버리거나 걸러낸 기록은 개수만 남긴다(시각은 지금)
+	if (Logger::dropped > 0 || Logger::suppressed > 0) {
+		struct tm tm;
+
+		if (used + 256 > LOG_BATCH_LEN) {
+			writeAll(Logger::fd, batch, used);
+			used = 0;
+		}
+		if ((stampSecond = time(NULL)) != SYS_FAILURE) {
+			localtime_r(&stampSecond, &tm);
+			strftime(stamp, sizeof(stamp), "%c", &tm);
+		}
+	}
+	if ((lost = __sync_fetch_and_and(&Logger::dropped, 0)) > 0)
+		used += snprintf(batch + used, LOG_BATCH_LEN - used, "[%s] WARN %lu log records dropped (ring full)\n", stamp, lost);
+	if ((lost = __sync_fetch_and_and(&Logger::suppressed, 0)) > 0)
+		used += snprintf(batch + used, LOG_BATCH_LEN - used, "[%s] WARN %lu log records suppressed (rate limit)\n", stamp, lost);
+	if (used > 0)
+		writeAll(Logger::fd, batch, used);
+}
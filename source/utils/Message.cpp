@@ -1,57 +1,79 @@
 #include "../../include/utils/Message.hpp"
-#include "../../include/utils/utils.hpp"
-#include "../../include/utils/Print.hpp"
-#include <sstream>
+#include "../../include/utils/Profiler.hpp"
 
-mesvec Message::comMes;
+Message::Message() : count(0), length(0) {}
 
-Message::Message() {}
+/*
+	<message> ::= [':' <prefix> <SPACE>] <command> <params>
+	<params>  ::= <SPACE> [':' <trailing> | <middle> <params>]
 
-Message::~Message() {}
+	1. 프레이머가 종결자를 떼고 넘겨주므로 줄 끝까지 보되, NUL을 만나면 거기서 끝난 것으로 본다
+	2. 단어 사이의 공백은 여러 개여도 하나로 본다
+	3. ':'로 시작하거나 15번째 인자는 줄 끝까지 통째로 하나의 인자가 된다
+*/
+bool Message::parse(StrView const& line) {
+	PROFILE_SCOPE(PHASE_PARSE);
+	char const* cur = line.data;
+	char const* end = line.data + line.size;
+	char const* start;
 
-void Message::parsMessage(std::string& origin) {
-	Message::comMes.clear();
+	for (char const* p = cur; p < end; p++) {
+		if (*p == '\0') {
+			end = p;
+			break ;
+		}
+	}
 
-	bool first = true;
-	std::istringstream str;
-	std::string tmp = "";
+	this->prefix = StrView();
+	this->count = 0;
+	this->length = line.size;
 
-	if (origin[origin.size() - 1] == '\r'
-		|| (origin[origin.size() - 2] != '\r' && origin[origin.size() - 1] == '\n'))
-		str.str(origin.substr(0, origin.size() - 1));
-	else
-		str.str(origin.substr(0, origin.size() - 2));
+	while (cur < end && *cur == ' ')
+		cur++;
+	if (cur < end && *cur == ':') {
+		start = ++cur;
+		while (cur < end && *cur != ' ')
+			cur++;
+		this->prefix = StrView(start, cur - start);
+	}
 
-	while (std::getline(str, tmp, ' ')) {
-		if (first) {
-			if (tmp.empty() || chkForbiddenChar(tmp, "\r\n\0"))
-				break ;
-			else
-				comMes.push_back(tmp);
-			first = false;
-		}
-		else {
-			if (tmp.empty())
-				continue ;
-			else if (tmp[0] == ':') {
-				comMes.push_back(tmp.substr(1, tmp.size()));
-				break;
-			}
-			else {
-				if (!chkForbiddenChar(tmp, ":\r\n\0"))
-					comMes.push_back(tmp);
-				else
-					break;
-			}
+	while (cur < end) {
+		while (cur < end && *cur == ' ')
+			cur++;
+		if (cur == end)
+			break ;
+		if (this->count > 0 && (*cur == ':' || this->count == MAX_PARAMS)) {
+			if (*cur == ':')
+				cur++;
+			this->words[this->count++] = StrView(cur, end - cur);
+			break ;
 		}
+		start = cur;
+		while (cur < end && *cur != ' ')
+			cur++;
+		this->words[this->count++] = StrView(start, cur - start);
 	}
+	return this->count > 0;
+}
+
+size_t Message::size() const {
+	return this->count;
+}
+
+StrView Message::operator[](size_t i) const {
+	if (i >= this->count)
+		return StrView();
+	return this->words[i];
+}
+
+StrView const& Message::getPrefix() const {
+	return this->prefix;
+}
 
-	tmp = "";
-	str >> tmp;
-	if (tmp != "")
-		comMes[comMes.size() - 1] += " " + tmp;
+StrView const& Message::getCommand() const {
+	return this->words[0];
 }
 
-mesvec const& Message::getMessage() {
-	return comMes;
+size_t Message::getLength() const {
+	return this->length;
 }
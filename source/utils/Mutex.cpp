@@ -0,0 +1,31 @@
+#include "../../include/utils/Mutex.hpp"
+
+Mutex::Mutex(bool recursive) {
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	if (recursive)
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&this->mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+Mutex::~Mutex() {
+	pthread_mutex_destroy(&this->mutex);
+}
+
+void Mutex::lock() {
+	pthread_mutex_lock(&this->mutex);
+}
+
+void Mutex::unlock() {
+	pthread_mutex_unlock(&this->mutex);
+}
+
+ScopedLock::ScopedLock(Mutex& mutex) : mutex(mutex) {
+	this->mutex.lock();
+}
+
+ScopedLock::~ScopedLock() {
+	this->mutex.unlock();
+}
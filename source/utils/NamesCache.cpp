@@ -0,0 +1,104 @@
+#include "../../include/utils/NamesCache.hpp"
+
+// 운영자 표시('@')와 구분 공백을 포함한 단어 하나의 최대 길이
+# define NAMES_TOKEN_LEN (USERNICK_LEN + 2)
+
+// 공백으로 나뉜 단어 중 name과 정확히 같은 것의 위치
+static size_t findToken(std::string const& text, std::string const& name) {
+	size_t pos = 0;
+
+	while ((pos = text.find(name, pos)) != std::string::npos) {
+		size_t end = pos + name.size();
+
+		if ((pos == 0 || text[pos - 1] == ' ') && (end == text.size() || text[end] == ' '))
+			return pos;
+		pos = end;
+	}
+	return std::string::npos;
+}
+
+// 단어와 그 앞(맨 앞이면 뒤)의 공백을 지운다
+static void eraseToken(std::string& text, size_t pos, size_t size) {
+	if (pos > 0)
+		text.erase(pos - 1, size + 1);
+	else if (size < text.size())
+		text.erase(0, size + 1);
+	else
+		text.clear();
+}
+
+NamesCache::NamesCache(size_t budget) : budget(budget) {
+}
+
+void NamesCache::refreshOpen(size_t chunk) {
+	if (this->chunks[chunk].size() + NAMES_TOKEN_LEN <= this->budget)
+		this->open.insert(chunk);
+	else
+		this->open.erase(chunk);
+}
+
+void NamesCache::trim() {
+	while (!this->chunks.empty() && this->chunks.back().empty()) {
+		this->open.erase(this->chunks.size() - 1);
+		this->chunks.pop_back();
+	}
+}
+
+void NamesCache::add(ClientHandle handle, std::string const& name) {
+	size_t chunk;
+
+	if (this->open.empty()) {
+		chunk = this->chunks.size();
+		this->chunks.push_back("");
+	} else
+		chunk = *this->open.begin();
+
+	std::string& text = this->chunks[chunk];
+
+	if (!text.empty())
+		text += ' ';
+	text += name;
+	this->chunkOf[handle] = chunk;
+	refreshOpen(chunk);
+}
+
+void NamesCache::remove(ClientHandle handle, std::string const& name) {
+	std::map<ClientHandle, size_t>::iterator it = this->chunkOf.find(handle);
+	size_t pos;
+
+	if (it == this->chunkOf.end())
+		return ;
+
+	std::string& text = this->chunks[it->second];
+
+	if ((pos = findToken(text, name)) != std::string::npos)
+		eraseToken(text, pos, name.size());
+	refreshOpen(it->second);
+	this->chunkOf.erase(it);
+	trim();
+}
+
+// 제자리에서 바꾸고, 길어져서 조각을 넘치면 빼서 다른 조각에 넣는다
+void NamesCache::rename(ClientHandle handle, std::string const& oldName, std::string const& newName) {
+	std::map<ClientHandle, size_t>::iterator it = this->chunkOf.find(handle);
+	size_t pos;
+
+	if (it == this->chunkOf.end())
+		return ;
+
+	std::string& text = this->chunks[it->second];
+
+	if ((pos = findToken(text, oldName)) == std::string::npos)
+		return ;
+	if (text.size() - oldName.size() + newName.size() <= this->budget) {
+		text.replace(pos, oldName.size(), newName);
+		refreshOpen(it->second);
+		return ;
+	}
+	remove(handle, oldName);
+	add(handle, newName);
+}
+
+std::vector<std::string> const& NamesCache::getChunks() const {
+	return this->chunks;
+}
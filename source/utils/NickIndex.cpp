@@ -0,0 +1,100 @@
+#include "../../include/utils/NickIndex.hpp"
+#include "../../include/utils/utils.hpp"
+
+# define NICKINDEX_MIN_CAPACITY 64 // 2의 거듭제곱
+
+NickIndex::NickIndex() : used(0), filled(0) {
+	Slot empty;
+
+	empty.state = EMPTY;
+	empty.client = NULL;
+	this->slots.assign(NICKINDEX_MIN_CAPACITY, empty);
+}
+
+// FNV-1a
+size_t NickIndex::hash(std::string const& key) {
+	size_t h = 2166136261u;
+
+	for (size_t i = 0; i < key.size(); i++) {
+		h ^= static_cast<unsigned char>(key[i]);
+		h *= 16777619u;
+	}
+	return h;
+}
+
+// key가 있는 칸, 없으면 key를 넣을 빈 칸. 테이블은 절반 넘게 차지 않으므로 항상 멈춘다
+size_t NickIndex::probe(std::string const& key) const {
+	size_t mask = this->slots.size() - 1;
+	size_t i = hash(key) & mask;
+	size_t reuse = this->slots.size();
+
+	while (this->slots[i].state != EMPTY) {
+		if (this->slots[i].state == USED && this->slots[i].key == key)
+			return i;
+		if (this->slots[i].state == DELETED && reuse == this->slots.size())
+			reuse = i;
+		i = (i + 1) & mask;
+	}
+	return reuse != this->slots.size() ? reuse : i;
+}
+
+void NickIndex::rehash(size_t capacity) {
+	std::vector<Slot> old;
+	Slot empty;
+
+	empty.state = EMPTY;
+	empty.client = NULL;
+	old.swap(this->slots);
+	this->slots.assign(capacity, empty);
+	this->used = 0;
+	this->filled = 0;
+	for (size_t i = 0; i < old.size(); i++) {
+		if (old[i].state != USED)
+			continue ;
+		Slot& slot = this->slots[this->probe(old[i].key)];
+		slot.state = USED;
+		slot.key.swap(old[i].key);
+		slot.client = old[i].client;
+		this->used++;
+		this->filled++;
+	}
+}
+
+Client* NickIndex::find(std::string const& nick) const {
+	Slot const& slot = this->slots[this->probe(foldNick(nick))];
+
+	return slot.state == USED ? slot.client : NULL;
+}
+
+void NickIndex::insert(std::string const& nick, Client* client) {
+	std::string key = foldNick(nick);
+
+	// 넣은 뒤에도 절반 이하로 차 있게 한다. 지운 칸이 많으면 크기는 두고 정리만 한다
+	if ((this->filled + 1) * 2 > this->slots.size())
+		this->rehash((this->used + 1) * 4 > this->slots.size() ? this->slots.size() * 2 : this->slots.size());
+
+	Slot& slot = this->slots[this->probe(key)];
+	if (slot.state != USED) {
+		if (slot.state == EMPTY)
+			this->filled++;
+		this->used++;
+		slot.state = USED;
+		slot.key = key;
+	}
+	slot.client = client;
+}
+
+void NickIndex::erase(std::string const& nick, Client const* client) {
+	Slot& slot = this->slots[this->probe(foldNick(nick))];
+
+	if (slot.state != USED || slot.client != client)
+		return ;
+	slot.state = DELETED;
+	slot.key.clear();
+	slot.client = NULL;
+	this->used--;
+}
+
+size_t NickIndex::size() const {
+	return this->used;
+}
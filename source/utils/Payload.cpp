@@ -0,0 +1,49 @@
+#include "../../include/utils/Payload.hpp"
+#include <cstring>
+#include <new>
+
+Payload::Payload(size_t size) : refs(1), size(size) {
+}
+
+Payload::~Payload() {
+}
+
+Payload* Payload::allocate(size_t size) {
+	void* block = ::operator new(sizeof(Payload) + size);
+
+	return new (block) Payload(size);
+}
+
+Payload* Payload::create(char const* data, size_t size) {
+	Payload* payload = allocate(size);
+
+	memcpy(payload->getWritable(), data, size);
+	return payload;
+}
+
+Payload* Payload::create(std::string const& message) {
+	return create(message.data(), message.size());
+}
+
+void Payload::retain() {
+	__sync_add_and_fetch(&this->refs, 1);
+}
+
+void Payload::release() {
+	if (__sync_sub_and_fetch(&this->refs, 1) == 0) {
+		this->~Payload();
+		::operator delete(this);
+	}
+}
+
+char const* Payload::getData() const {
+	return reinterpret_cast<char const*>(this) + sizeof(Payload);
+}
+
+char* Payload::getWritable() {
+	return reinterpret_cast<char*>(this) + sizeof(Payload);
+}
+
+size_t Payload::getSize() const {
+	return this->size;
+}
@@ -0,0 +1,119 @@
+#include "../../include/utils/Profiler.hpp"
+#include "../../include/utils/Logger.hpp"
+#include <cstdio>
+#include <cstring>
+
+THREAD_LOCAL Profiler* Profiler::local = NULL;
+
+static char const* phaseName[PHASE_COUNT] = {
+	"loop", "wait", "accept", "mailbox", "read", "frame", "parse", "dispatch", "write", "timers", "flush", "close"
+};
+
+Profiler::Profiler(int id) : id(id), phase(PHASE_LOOP), mark(now()), reportStamp(getCurTime()) {
+	reset();
+	this->iterationStart = this->mark;
+}
+
+void Profiler::bind(Profiler* profiler) {
+	local = profiler;
+}
+
+Profiler* Profiler::getLocal() {
+	return local;
+}
+
+unsigned long Profiler::now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<unsigned long>(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+}
+
+void Profiler::reset() {
+	memset(this->phaseTime, 0, sizeof(this->phaseTime));
+	this->iterations = 0;
+	this->events = 0;
+	this->maxEvents = 0;
+	this->busyTotal = 0;
+	this->maxBusy = 0;
+}
+
+ProfilePhase Profiler::enter(ProfilePhase next) {
+	unsigned long cur = now();
+	ProfilePhase previous = this->phase;
+
+	this->phaseTime[previous] += cur - this->mark;
+	this->mark = cur;
+	this->phase = next;
+	return previous;
+}
+
+// 바퀴의 바쁜 시간은 깨어난 때부터 다시 기다리기 직전까지
+void Profiler::beginWait() {
+	unsigned long busy;
+
+	enter(PHASE_WAIT);
+	busy = this->mark - this->iterationStart;
+	this->busyTotal += busy;
+	if (busy > this->maxBusy)
+		this->maxBusy = busy;
+}
+
+void Profiler::endWait(int cntEvents) {
+	enter(PHASE_LOOP);
+	this->iterationStart = this->mark;
+	this->iterations++;
+	if (cntEvents <= 0)
+		return ;
+	this->events += cntEvents;
+	if (static_cast<unsigned long>(cntEvents) > this->maxEvents)
+		this->maxEvents = cntEvents;
+}
+
+/**
+ * 두 줄로 남긴다.
+ * 1. 바퀴 수, 기다린 시간의 비율, 바퀴당 이벤트 수(평균, 최대), 바퀴당 바쁜 시간(평균, 최대)
+ * 2. wait를 뺀 구간별로 바쁜 시간에서 차지한 비율
+ */
+void Profiler::report(time_t now) {
+	char line[LOG_RECORD_LEN];
+	unsigned long total = 0;
+	unsigned long busy;
+	size_t used;
+
+	if (now - this->reportStamp < PROFILE_INTERVAL)
+		return ;
+	enter(this->phase);
+	for (size_t i = 0; i < PHASE_COUNT; i++)
+		total += this->phaseTime[i];
+	busy = total - this->phaseTime[PHASE_WAIT];
+	if (this->iterations == 0 || busy == 0) {
+		reset();
+		this->reportStamp = now;
+		return ;
+	}
+	Logger::log(LOG_INFO, CYAN, "profile r%d : %lu loops in %lds, wait %.1f%%, events/loop avg %.1f max %lu, busy/loop avg %.1fus max %.1fus",
+		this->id, this->iterations, static_cast<long>(now - this->reportStamp), this->phaseTime[PHASE_WAIT] * 100.0 / total,
+		static_cast<double>(this->events) / this->iterations, this->maxEvents,
+		this->busyTotal / 1000.0 / this->iterations, this->maxBusy / 1000.0);
+
+	used = snprintf(line, sizeof(line), "profile r%d : busy", this->id);
+	for (size_t i = 0; i < PHASE_COUNT && used < sizeof(line); i++) {
+		if (i != PHASE_WAIT)
+			used += snprintf(line + used, sizeof(line) - used, " %s %.1f%%", phaseName[i], this->phaseTime[i] * 100.0 / busy);
+	}
+	Logger::log(LOG_INFO, CYAN, "%s", line);
+
+	reset();
+	this->reportStamp = now;
+}
+
+ProfileScope::ProfileScope(ProfilePhase phase) : profiler(Profiler::getLocal()), previous(phase) {
+	if (this->profiler != NULL)
+		this->previous = this->profiler->enter(phase);
+}
+
+ProfileScope::~ProfileScope() {
+	if (this->profiler != NULL)
+		this->profiler->enter(this->previous);
+}
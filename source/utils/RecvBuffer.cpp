@@ -0,0 +1,50 @@
+#include "../../include/utils/RecvBuffer.hpp"
+#include "../../include/utils/utils.hpp"
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+
+RecvBuffer::RecvBuffer() : head(0), tail(0) {
+}
+
+ssize_t RecvBuffer::readFrom(int fd) {
+	ssize_t byte;
+
+	// 뒤쪽 공간이 없으면 남은 줄을 앞으로 당긴다
+	if (this->tail == RECV_BUFFER_SIZE && this->head > 0) {
+		memmove(this->data, this->data + this->head, this->tail - this->head);
+		this->tail -= this->head;
+		this->head = 0;
+	}
+	// 처리하지 않은 줄로 가득 찼다. 길이 0으로 recv 하면 0(연결 끊김과 같은 값)이 돌아오므로 읽지 않는다
+	if (this->tail == RECV_BUFFER_SIZE) {
+		errno = EAGAIN;
+		return SYS_FAILURE;
+	}
+	byte = recv(fd, this->data + this->tail, RECV_BUFFER_SIZE - this->tail, 0);
+	if (byte > 0)
+		this->tail += byte;
+	return byte;
+}
+
+char const* RecvBuffer::begin() const {
+	return this->data + this->head;
+}
+
+size_t RecvBuffer::size() const {
+	return this->tail - this->head;
+}
+
+void RecvBuffer::consume(size_t n) {
+	this->head += n;
+	// 다 처리했으면 처음으로 되돌려서 당기는 일을 줄인다
+	if (this->head >= this->tail) {
+		this->head = 0;
+		this->tail = 0;
+	}
+}
+
+void RecvBuffer::clear() {
+	this->head = 0;
+	this->tail = 0;
+}
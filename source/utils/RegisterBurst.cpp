@@ -0,0 +1,90 @@
+#include "../../include/utils/RegisterBurst.hpp"
+#include "../../include/utils/reply.hpp"
+#include "../../include/utils/utils.hpp"
+#include <cstring>
+
+// 틀을 만들 때만 쓰는 자리 표시. 제어 문자라 서버 이름에는 나오지 않는다(MOTD는 CTCP의 \x01을 담을 수 있어서 값으로 붙인다)
+static char const* const markNick = "\x01N";
+static char const* const markUser = "\x01U";
+static char const* const markHost = "\x01H";
+static char const* const markMotd = "\x01M";
+
+RegisterBurst::RegisterBurst() {
+}
+
+void RegisterBurst::build(std::string const& serverHost, time_t const& startTime, std::string const& motd) {
+	std::string nick = markNick;
+	std::string burst;
+	std::string text;
+	size_t begin = 0;
+	size_t pos;
+
+	burst += reply::RPL_WELCOME(serverHost, nick, markUser, markHost).str();
+	burst += reply::RPL_YOURHOST(serverHost, nick, "1.0").str();
+	burst += reply::RPL_CREATED(serverHost, nick, getStringTime(startTime)).str();
+	burst += reply::RPL_MYINFO(serverHost, nick, "ircserv 1.0", "x", "itkol").str();
+	burst += reply::RPL_ISUPPORT(serverHost, nick).str();
+	burst += reply::RPL_MOTDSTART(serverHost, nick).str();
+	burst += reply::RPL_MOTD(serverHost, nick, markMotd).str();
+	burst += reply::RPL_ENDOFMOTD(serverHost, nick).str();
+
+	this->segments.clear();
+	while ((pos = burst.find('\x01', begin)) != std::string::npos) {
+		Segment segment;
+
+		text.append(burst, begin, pos - begin);
+		begin = pos + 2;
+		// MOTD는 클라이언트마다 같으니 고정 조각에 이어 붙인다
+		if (burst[pos + 1] == 'M') {
+			text += motd;
+			continue ;
+		}
+		segment.text = text;
+		text.clear();
+		switch (burst[pos + 1]) {
+			case 'N':
+				segment.field = FIELD_NICK;
+				break;
+			case 'U':
+				segment.field = FIELD_USER;
+				break;
+			default:
+				segment.field = FIELD_HOST;
+				break;
+		}
+		this->segments.push_back(segment);
+	}
+	Segment last;
+
+	last.text = text + burst.substr(begin);
+	last.field = FIELD_NONE;
+	this->segments.push_back(last);
+}
+
+Reply RegisterBurst::render(std::string const& nick, std::string const& user, std::string const& host) const {
+	std::string const* values[] = { NULL, &nick, &user, &host };
+	size_t length = 0;
+
+	for (size_t i = 0; i < this->segments.size(); i++) {
+		length += this->segments[i].text.size();
+		if (this->segments[i].field != FIELD_NONE)
+			length += values[this->segments[i].field]->size();
+	}
+
+	Payload* payload = Payload::allocate(length);
+	char* dst = payload->getWritable();
+
+	for (size_t i = 0; i < this->segments.size(); i++) {
+		Segment const& segment = this->segments[i];
+
+		memcpy(dst, segment.text.data(), segment.text.size());
+		dst += segment.text.size();
+		if (segment.field != FIELD_NONE) {
+			std::string const& value = *values[segment.field];
+
+			memcpy(dst, value.data(), value.size());
+			dst += value.size();
+		}
+	}
+	return Reply(payload);
+}
@@ -0,0 +1,79 @@
+#include "../../include/utils/ReplyFormat.hpp"
+#include <cstring>
+#include <stdexcept>
+
+Reply::Reply() : payload(NULL) {
+}
+
+Reply::Reply(Payload* payload) : payload(payload) {
+}
+
+Reply::Reply(Reply const& ref) : payload(ref.payload) {
+	if (this->payload != NULL)
+		this->payload->retain();
+}
+
+Reply& Reply::operator=(Reply const& ref) {
+	if (ref.payload != NULL)
+		ref.payload->retain();
+	if (this->payload != NULL)
+		this->payload->release();
+	this->payload = ref.payload;
+	return *this;
+}
+
+Reply::~Reply() {
+	if (this->payload != NULL)
+		this->payload->release();
+}
+
+Payload* Reply::get() const {
+	return this->payload;
+}
+
+size_t Reply::size() const {
+	return this->payload != NULL ? this->payload->getSize() : 0;
+}
+
+std::string Reply::str() const {
+	if (this->payload == NULL)
+		return "";
+	return std::string(this->payload->getData(), this->payload->getSize());
+}
+
+ReplyFormat::ReplyFormat() : count(0), length(0) {
+}
+
+void ReplyFormat::append(char const* data, size_t size) {
+	if (this->count == REPLY_MAX_PIECES)
+		throw std::runtime_error("Error : too many reply pieces");
+	this->pieces[this->count++] = StrView(data, size);
+	this->length += size;
+}
+
+ReplyFormat& ReplyFormat::operator<<(std::string const& str) {
+	this->append(str.data(), str.size());
+	return *this;
+}
+
+ReplyFormat& ReplyFormat::operator<<(StrView const& str) {
+	this->append(str.data, str.size);
+	return *this;
+}
+
+ReplyFormat& ReplyFormat::operator<<(char c) {
+	this->chars[this->count] = c;
+	this->append(&this->chars[this->count], 1);
+	return *this;
+}
+
+Reply ReplyFormat::done() const {
+	Payload* payload = Payload::allocate(this->length);
+	char* dst = payload->getWritable();
+
+	for (size_t i = 0; i < this->count; i++) {
+		memcpy(dst, this->pieces[i].data, this->pieces[i].size);
+		dst += this->pieces[i].size;
+	}
+	return Reply(payload);
+}
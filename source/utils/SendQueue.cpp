@@ -0,0 +1,106 @@
+#include "../../include/utils/SendQueue.hpp"
+#include "../../include/utils/utils.hpp"
+#include <sys/uio.h>
+#include <cerrno>
+
+SendQueue::SendQueue() : offset(0), pending(0), scheduled(false), limit(0), overflowed(false) {
+}
+
+SendQueue::~SendQueue() {
+	this->clear();
+}
+
+bool SendQueue::push(Payload* payload) {
+	if (payload->getSize() == 0)
+		return true;
+	if (this->overflowed || (this->limit != 0 && this->pending + payload->getSize() > this->limit)) {
+		this->overflowed = true;
+		return false;
+	}
+	payload->retain();
+	this->chunks.push_back(payload);
+	this->pending += payload->getSize();
+	return true;
+}
+
+// 앞에서부터 n 바이트를 보냈다. 다 보낸 조각은 참조를 놓는다
+void SendQueue::consume(size_t n) {
+	this->pending -= n;
+	while (n > 0) {
+		Payload* front = this->chunks.front();
+		size_t left = front->getSize() - this->offset;
+
+		if (n < left) {
+			this->offset += n;
+			return ;
+		}
+		n -= left;
+		this->offset = 0;
+		front->release();
+		this->chunks.pop_front();
+	}
+}
+
+ssize_t SendQueue::flush(int fd) {
+	struct iovec iov[SENDQUEUE_IOV_MAX];
+	ssize_t total = 0;
+
+	while (this->pending > 0) {
+		size_t cnt = 0;
+		size_t bytes = 0;
+		ssize_t written;
+
+		for (std::deque<Payload*>::iterator it = this->chunks.begin(); it != this->chunks.end() && cnt < SENDQUEUE_IOV_MAX; it++, cnt++) {
+			size_t skip = cnt == 0 ? this->offset : 0;
+
+			iov[cnt].iov_base = const_cast<char*>((*it)->getData() + skip);
+			iov[cnt].iov_len = (*it)->getSize() - skip;
+			bytes += iov[cnt].iov_len;
+		}
+		written = writev(fd, iov, cnt);
+		if (written == SYS_FAILURE) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+				return total;
+			return SYS_FAILURE;
+		}
+		this->consume(written);
+		total += written;
+		// 소켓 버퍼가 찼다. 나머지는 다음 쓰기 이벤트에
+		if (static_cast<size_t>(written) < bytes)
+			break ;
+	}
+	return total;
+}
+
+bool SendQueue::empty() const {
+	return this->pending == 0;
+}
+
+size_t SendQueue::size() const {
+	return this->pending;
+}
+
+void SendQueue::clear() {
+	for (size_t i = 0; i < this->chunks.size(); i++)
+		this->chunks[i]->release();
+	this->chunks.clear();
+	this->offset = 0;
+	this->pending = 0;
+	this->overflowed = false;
+}
+
+bool SendQueue::isScheduled() const {
+	return this->scheduled;
+}
+
+void SendQueue::setScheduled(bool flag) {
+	this->scheduled = flag;
+}
+
+void SendQueue::setLimit(size_t limit) {
+	this->limit = limit;
+}
+
+bool SendQueue::isOverflowed() const {
+	return this->overflowed;
+}
@@ -0,0 +1,214 @@
+#include "../../include/utils/Stats.hpp"
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+THREAD_LOCAL Stats* Stats::local = NULL;
+volatile sig_atomic_t Stats::dumpRequested = 0;
+
+static char const* counterName[STAT_COUNTERS] = {
+	"ev_accept", "ev_read", "ev_write", "ev_error", "ev_wake", "ev_timer", "loops",
+	"bytes_in", "bytes_out", "lines_in", "recv_calls", "writev_calls", "partial_writes",
+	"sendq_evictions", "flood_throttles"
+};
+
+LatencyHistogram::LatencyHistogram() : total(0), sum(0), max(0) {
+	memset(this->counts, 0, sizeof(this->counts));
+}
+
+/**
+ * 8보다 작은 값은 값 그대로 칸 번호가 된다.
+ * 그보다 크면 가장 높은 비트 위치(exp)로 구간을 고르고, 그 아래 3비트로 구간 안의 칸을 고른다.
+ */
+static size_t bucketOf(unsigned long value) {
+	int exp = 0;
+	size_t index;
+
+	if (value < STATS_HIST_SUB)
+		return value;
+	while ((value >> exp) >= (STATS_HIST_SUB << 1))
+		exp++;
+	index = (exp + 1) * STATS_HIST_SUB + ((value >> exp) - STATS_HIST_SUB);
+	return index < STATS_HIST_BUCKETS ? index : STATS_HIST_BUCKETS - 1;
+}
+
+static unsigned long bucketUpper(size_t index) {
+	int exp;
+
+	if (index < STATS_HIST_SUB)
+		return index;
+	exp = index / STATS_HIST_SUB - 1;
+	return ((static_cast<unsigned long>(index % STATS_HIST_SUB) + STATS_HIST_SUB + 1) << exp) - 1;
+}
+
+void LatencyHistogram::record(unsigned long value) {
+	this->counts[bucketOf(value)]++;
+	this->total++;
+	this->sum += value;
+	if (value > this->max)
+		this->max = value;
+}
+
+void LatencyHistogram::merge(LatencyHistogram const& other) {
+	for (size_t i = 0; i < STATS_HIST_BUCKETS; i++)
+		this->counts[i] += other.counts[i];
+	this->total += other.total;
+	this->sum += other.sum;
+	if (other.max > this->max)
+		this->max = other.max;
+}
+
+unsigned long LatencyHistogram::percentile(double p) const {
+	unsigned long rank = static_cast<unsigned long>(std::ceil(this->total * p));
+	unsigned long seen = 0;
+
+	if (this->total == 0)
+		return 0;
+	for (size_t i = 0; i < STATS_HIST_BUCKETS; i++) {
+		seen += this->counts[i];
+		if (seen >= rank && seen > 0)
+			return bucketUpper(i) < this->max ? bucketUpper(i) : this->max;
+	}
+	return this->max;
+}
+
+CommandStats::CommandStats() : calls(0), bytes(0) {}
+
+Stats::Stats(CommandEntry const* entries, size_t entryCount) : entries(entries), entryCount(entryCount), commands(entryCount + 1), clientCount(0), sendqTotal(0), sendqMax(0), recvqTotal(0), recvqMax(0), depthStamp(0) {
+	memset(this->counters, 0, sizeof(this->counters));
+}
+
+void Stats::bind(Stats* stats) {
+	local = stats;
+}
+
+Stats* Stats::getLocal() {
+	return local;
+}
+
+unsigned long Stats::now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<unsigned long>(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+}
+
+void Stats::count(StatsCounter counter, unsigned long n) {
+	if (local != NULL)
+		local->counters[counter] += n;
+}
+
+// 테이블에 없는 명령어(entry가 NULL이거나 다른 테이블의 것)는 마지막 칸에 센다
+void Stats::recordCommand(CommandEntry const* entry, size_t bytes, unsigned long elapsed) {
+	size_t index;
+
+	if (local == NULL)
+		return ;
+	index = local->entryCount;
+	if (entry != NULL && entry >= local->entries && entry < local->entries + local->entryCount)
+		index = entry - local->entries;
+	local->commands[index].calls++;
+	local->commands[index].bytes += bytes;
+	local->commands[index].latency.record(elapsed);
+}
+
+bool Stats::isDepthStale(time_t now) const {
+	return now != this->depthStamp;
+}
+
+void Stats::setDepth(time_t now, size_t clients, size_t sendqTotal, size_t sendqMax, size_t recvqTotal, size_t recvqMax) {
+	this->depthStamp = now;
+	this->clientCount = clients;
+	this->sendqTotal = sendqTotal;
+	this->sendqMax = sendqMax;
+	this->recvqTotal = recvqTotal;
+	this->recvqMax = recvqMax;
+}
+
+void Stats::merge(Stats const& other) {
+	for (size_t i = 0; i < this->commands.size() && i < other.commands.size(); i++) {
+		this->commands[i].calls += other.commands[i].calls;
+		this->commands[i].bytes += other.commands[i].bytes;
+		this->commands[i].latency.merge(other.commands[i].latency);
+	}
+	for (size_t i = 0; i < STAT_COUNTERS; i++)
+		this->counters[i] += other.counters[i];
+	this->clientCount += other.clientCount;
+	this->sendqTotal += other.sendqTotal;
+	this->recvqTotal += other.recvqTotal;
+	if (other.sendqMax > this->sendqMax)
+		this->sendqMax = other.sendqMax;
+	if (other.recvqMax > this->recvqMax)
+		this->recvqMax = other.recvqMax;
+}
+
+void Stats::reset() {
+	for (size_t i = 0; i < this->commands.size(); i++)
+		this->commands[i] = CommandStats();
+	memset(this->counters, 0, sizeof(this->counters));
+	this->clientCount = 0;
+	this->sendqTotal = 0;
+	this->sendqMax = 0;
+	this->recvqTotal = 0;
+	this->recvqMax = 0;
+	this->depthStamp = 0;
+}
+
+/**
+ * m : 한 번이라도 불린 명령어마다 "이름 호출수 바이트 avg p50 p99 p999 max"(시간은 us)
+ * e : 카운터마다 "이름 값", 마지막에 큐 깊이
+ */
+void Stats::describe(char query, std::vector<std::string>& lines) const {
+	char line[256];
+
+	if (query == 'm') {
+		for (size_t i = 0; i < this->commands.size(); i++) {
+			CommandStats const& command = this->commands[i];
+			LatencyHistogram const& latency = command.latency;
+
+			if (command.calls == 0)
+				continue ;
+			snprintf(line, sizeof(line), "%s calls=%lu bytes=%lu avg=%.1fus p50=%.1fus p99=%.1fus p999=%.1fus max=%.1fus",
+				i < this->entryCount ? this->entries[i].name : "(unknown)", command.calls, command.bytes,
+				latency.sum / 1000.0 / latency.total, latency.percentile(0.5) / 1000.0, latency.percentile(0.99) / 1000.0,
+				latency.percentile(0.999) / 1000.0, latency.max / 1000.0);
+			lines.push_back(line);
+		}
+	} else if (query == 'e') {
+		for (size_t i = 0; i < STAT_COUNTERS; i++) {
+			snprintf(line, sizeof(line), "%s=%lu", counterName[i], this->counters[i]);
+			lines.push_back(line);
+		}
+		snprintf(line, sizeof(line), "clients=%lu sendq_bytes=%lu sendq_max=%lu recvq_bytes=%lu recvq_max=%lu",
+			static_cast<unsigned long>(this->clientCount), static_cast<unsigned long>(this->sendqTotal), static_cast<unsigned long>(this->sendqMax),
+			static_cast<unsigned long>(this->recvqTotal), static_cast<unsigned long>(this->recvqMax));
+		lines.push_back(line);
+	}
+}
+
+size_t Stats::getEntryCount() const {
+	return this->entryCount;
+}
+
+CommandEntry const& Stats::getEntry(size_t index) const {
+	return this->entries[index];
+}
+
+CommandStats const& Stats::getCommand(size_t index) const {
+	return this->commands[index];
+}
+
+unsigned long Stats::getCounter(StatsCounter counter) const {
+	return this->counters[counter];
+}
+
+void Stats::requestDump() {
+	dumpRequested = 1;
+}
+
+bool Stats::takeDumpRequest() {
+	if (!dumpRequested)
+		return false;
+	dumpRequested = 0;
+	return true;
+}
@@ -0,0 +1,42 @@
+#include "../../include/utils/StrView.hpp"
+#include <cstring>
+
+StrView::StrView() : data(""), size(0) {
+}
+
+StrView::StrView(char const* data, size_t size) : data(data), size(size) {
+}
+
+char StrView::operator[](size_t i) const {
+	if (i >= this->size)
+		return 0;
+	return this->data[i];
+}
+
+bool StrView::empty() const {
+	return this->size == 0;
+}
+
+std::string StrView::str() const {
+	return std::string(this->data, this->size);
+}
+
+StrView::operator std::string() const {
+	return std::string(this->data, this->size);
+}
+
+bool operator==(StrView const& lhs, char const* rhs) {
+	return strncmp(lhs.data, rhs, lhs.size) == 0 && rhs[lhs.size] == 0;
+}
+
+bool operator==(StrView const& lhs, std::string const& rhs) {
+	return lhs.size == rhs.size() && memcmp(lhs.data, rhs.data(), lhs.size) == 0;
+}
+
+bool operator!=(StrView const& lhs, char const* rhs) {
+	return !(lhs == rhs);
+}
+
+bool operator!=(StrView const& lhs, std::string const& rhs) {
+	return !(lhs == rhs);
+}
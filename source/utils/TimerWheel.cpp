@@ -0,0 +1,146 @@
+#include "../../include/utils/TimerWheel.hpp"
+#include <cstddef>
+
+TimerNode::TimerNode() : prev(NULL), next(NULL), expire(0), owner(NULL) {
+}
+
+bool TimerNode::isLinked() const {
+	return this->next != NULL;
+}
+
+TimerWheel::TimerWheel() : current(0), count(0) {
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		for (int i = 0; i < WHEEL_SIZE; i++) {
+			this->slots[level][i].prev = &this->slots[level][i];
+			this->slots[level][i].next = &this->slots[level][i];
+		}
+	}
+}
+
+void TimerWheel::start(time_t now) {
+	this->current = now;
+}
+
+void TimerWheel::unlink(TimerNode* node) {
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->prev = NULL;
+	node->next = NULL;
+}
+
+/**
+ * 남은 시간에 맞는 단과 칸에 넣는다.
+ * 이미 지난 마감은 earliest 눈금의 칸에 넣는다.
+ * 1. schedule()에서는 지금 눈금이 이미 처리됐으니 다음 눈금(current + 1)
+ * 2. advance() 안에서 풀어 내릴 때는 지금 눈금(current). 이 눈금의 아래 단 칸은 풀어 내린 뒤에 처리하므로 늦지 않는다
+ */
+void TimerWheel::place(TimerNode* node, time_t earliest) {
+	time_t expire = node->expire;
+	time_t delta;
+	TimerNode* head;
+	int level = 0;
+
+	if (expire < earliest)
+		expire = earliest;
+	delta = expire - this->current;
+	while (level < WHEEL_LEVELS - 1 && delta >= (static_cast<time_t>(1) << (WHEEL_BITS * (level + 1))))
+		level++;
+	if (delta >= (static_cast<time_t>(1) << (WHEEL_BITS * WHEEL_LEVELS)))
+		expire = this->current + (static_cast<time_t>(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+	head = &this->slots[level][(expire >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1)];
+	node->prev = head->prev;
+	node->next = head;
+	head->prev->next = node;
+	head->prev = node;
+}
+
+// 위 단의 한 칸을 통째로 떼어서 남은 시간에 맞게 다시 넣는다
+void TimerWheel::cascade(int level, size_t index) {
+	TimerNode* head = &this->slots[level][index];
+	TimerNode* node = head->next;
+
+	head->prev = head;
+	head->next = head;
+	while (node != head) {
+		TimerNode* next = node->next;
+
+		this->place(node, this->current);
+		node = next;
+	}
+}
+
+void TimerWheel::schedule(TimerNode* node, time_t expire) {
+	if (node->isLinked())
+		unlink(node);
+	else
+		this->count++;
+	node->expire = expire;
+	this->place(node, this->current + 1);
+}
+
+void TimerWheel::cancel(TimerNode* node) {
+	if (!node->isLinked())
+		return ;
+	unlink(node);
+	this->count--;
+}
+
+/**
+ * 눈금을 하나씩 넘기면서
+ * 1. 아래 단이 0번 칸으로 돌아오면 위 단의 해당 칸을 풀어 내린다(위 단부터)
+ * 2. 아래 단의 현재 칸에 있는 타이머를 전부 만료시킨다
+ * 시계가 뒤로 가면 아무것도 하지 않는다.
+ */
+void TimerWheel::advance(time_t now, std::vector<TimerNode*>& expired) {
+	while (this->current < now) {
+		size_t index;
+		TimerNode* head;
+
+		this->current++;
+		if (this->count == 0) {
+			this->current = now;
+			break ;
+		}
+		index = this->current & (WHEEL_SIZE - 1);
+		if (index == 0) {
+			size_t index1 = (this->current >> WHEEL_BITS) & (WHEEL_SIZE - 1);
+
+			if (index1 == 0)
+				this->cascade(2, (this->current >> (WHEEL_BITS * 2)) & (WHEEL_SIZE - 1));
+			this->cascade(1, index1);
+		}
+		head = &this->slots[0][index];
+		while (head->next != head) {
+			TimerNode* node = head->next;
+
+			unlink(node);
+			this->count--;
+			expired.push_back(node);
+		}
+	}
+}
+
+/**
+ * 아래 단에서 가장 가까운 비어 있지 않은 칸까지의 시간.
+ * 아래 단이 비어 있으면 다음에 위 단을 풀어 내리는 시점까지 기다린다.
+ */
+int TimerWheel::nextTimeout(time_t now) const {
+	time_t wait = WHEEL_SIZE - (this->current & (WHEEL_SIZE - 1));
+
+	if (this->count == 0)
+		return -1;
+	for (time_t tick = 1; tick < WHEEL_SIZE; tick++) {
+		TimerNode const* head = &this->slots[0][(this->current + tick) & (WHEEL_SIZE - 1)];
+
+		if (head->next != head) {
+			wait = tick;
+			break ;
+		}
+	}
+	wait = this->current + wait - now;
+	return wait > 0 ? static_cast<int>(wait * 1000) : 0;
+}
+
+size_t TimerWheel::size() const {
+	return this->count;
+}
@@ -1,79 +1,105 @@
 #include "../../include/utils/error.hpp"
 
-std::string const suffix = "\r\n";
+Reply const error::ERR_INPUTTOOLONG(std::string const& serverHost) {
+	return (ReplyFormat() << ":" << serverHost << " 417 :Input line was too long" << CRLF).done();
+}
+
+Reply const error::ERR_NEEDMOREPARAMS(std::string const& serverHost, std::string const& command) {
+	return (ReplyFormat() << ":" << serverHost << " 461 " << command << " :Not enough parameters" << CRLF).done();
+}
+
+Reply const error::ERR_ALREADYREGISTERED(std::string const& serverHost) {
+	return (ReplyFormat() << ":" << serverHost << " 462 :You may not reregister" << CRLF).done();
+}
+
+Reply const error::ERR_PASSWDMISMATCH(std::string const& serverHost) {
+	return (ReplyFormat() << ":" << serverHost << " 464 :Password incorrect" << CRLF).done();
+}
+
+Reply const error::ERR_NONICKNAMEGIVEN(std::string const& serverHost) {
+	return (ReplyFormat() << ":" << serverHost << " 431 :No nickname given" << CRLF).done();
+}
+
+Reply const error::ERR_NICKNAMEINUSE(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 433 " << nick << " :Nickname is already in use" << CRLF).done();
+}
+
+Reply const error::ERR_ERRONEUSNICKNAME(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 432 " << nick << " :Erroneus nickname" << CRLF).done();
+}
 
-std::string const error::ERR_INPUTTOOLONG(std::string const& serverHost) {
-	return ":" + serverHost + " 417 :Input line was too long" + suffix;
+Reply const error::ERR_NOTREGISTERED(std::string const& serverHost, std::string const& reason) {
+	return (ReplyFormat() << ":" << serverHost << " 451 :" << reason << CRLF).done();
 }
 
-std::string const error::ERR_NEEDMOREPARAMS(std::string const& serverHost, std::string const& command) {
-	return ":" + serverHost + " 461 " + command + " :Not enough parameters" + suffix;
+Reply const error::ERR_UNKNOWNCOMMAND(std::string const& serverHost, std::string const& command) {
+	return (ReplyFormat() << ":" << serverHost << " 421 " << command << " :Unknown Command" << CRLF).done();
 }
 
-std::string const error::ERR_ALREADYREGISTERED(std::string const& serverHost) {
-	return ":" + serverHost + " 462 :You may not reregister" + suffix;
+Reply const error::ERR_NOORIGIN(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 409 " << nick << " :No origin specified" << CRLF).done();
 }
 
-std::string const error::ERR_PASSWDMISMATCH(std::string const& serverHost) {
-	return ":" + serverHost + " 464 :Password incorrect" + suffix;
+Reply const error::ERR_INVALIDMODEPARAM(std::string const& serverHost, std::string const& nick, std::string const& chName, char const& mode, std::string const& reason) {
+	return (ReplyFormat() << ":" << serverHost << " 696 " << nick << " " << chName << " " << mode << " :" << reason << CRLF).done();
 }
 
-std::string const error::ERR_NONICKNAMEGIVEN(std::string const& serverHost) {
-	return ":" + serverHost + " 431 :No nickname given" + suffix;
+Reply const error::ERR_UNKNOWNMODE(std::string const& serverHost, std::string const& nick, char const& mode) {
+	return (ReplyFormat() << ":" << serverHost << " 472 " << nick << " " << mode << " :is not a recognised channel mode" << CRLF).done();
 }
 
-std::string const error::ERR_NICKNAMEINUSE(std::string const& serverHost, std::string const& nick) {
-	return ":" + serverHost + " 433 " + nick + " :Nickname is already in use" + suffix;
+Reply const error::ERR_NOSUCHCHANNEL(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 403 " << nick << " " << chName << " :No such channel" << CRLF).done();
 }
 
-std::string const error::ERR_ERRONEUSNICKNAME(std::string const& serverHost, std::string const& nick) {
-	return ":" + serverHost + " 432 " + nick + " :Erroneus nickname" + suffix;
+Reply const error::ERR_CHANOPRIVSNEEDED(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 482 " << nick << " " << chName << " :You're not channel operator" << CRLF).done();
 }
 
-std::string const error::ERR_NOTREGISTERED(std::string const& serverHost, std::string const& reason) {
-	return ":" + serverHost + " 451 :" + reason + suffix;
+Reply const error::ERR_BADCHANMASK(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 476 " << nick << " " << chName << " :Bad Channel Mask" << CRLF).done();
 }
 
-std::string const error::ERR_UNKNOWNCOMMAND(std::string const& serverHost, std::string const& command) {
-	return ":" + serverHost + " 421 " + command + " :Unknown Command" + suffix;
+Reply const error::ERR_TOOMANYCHANNELS(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 405 " << nick << " " << chName << " :You have joined too many channels" << CRLF).done();
 }
 
-std::string const error::ERR_NOORIGIN(std::string const& serverHost, std::string const& nick) {
-	return ":" + serverHost + " 409 " + nick + " :No origin specified" + suffix;
+Reply const error::ERR_CHANNELISFULL(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 471 " << nick << " " << chName << " :Cannot join channel (+l)" << CRLF).done();
 }
 
-std::string const error::ERR_INVALIDMODEPARAM(std::string const& serverHost, std::string const& nick, std::string const& chName, char const& mode, std::string const& reason) {
-	return ":" + serverHost + " 696 " + nick + " " + chName + " " + mode + " :" + reason + suffix;
+Reply const error::ERR_INVITEONLYCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 473 " << nick << " " << chName << " :Cannot join channel (+i)" << CRLF).done();
 }
 
-std::string const error::ERR_UNKNOWNMODE(std::string const& serverHost, std::string const& nick, char const& mode) {
-	return ":" + serverHost + " 472 " + nick + " " + mode + " :is not a recognised channel mode" + suffix;
+Reply const error::ERR_BADCHANNELKEY(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 475 " << nick << " " << chName << " :Cannot join channel (+k)" << CRLF).done();
 }
 
-std::string const error::ERR_NOSUCHCHANNEL(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 403 " + nick + " " + chName + " :No such channel" + suffix;
+Reply const error::ERR_NOSUCHNICK(std::string const& serverHost, std::string const& nick, std::string const& target) {
+	return (ReplyFormat() << ":" << serverHost << " 401 " << nick << " " << target << " :No such nick/channel" << CRLF).done();
 }
 
-std::string const error::ERR_CHANOPRIVSNEEDED(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 482 " + nick + " " + chName + " :You're not channel operator" + suffix;
+Reply const error::ERR_CANNOTSENDTOCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 404 " << nick << " " << chName << " :Cannot send to channel" << CRLF).done();
 }
 
-std::string const error::ERR_BADCHANMASK(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 476 " + nick + " " + chName + " :Bad Channel Mask" + suffix;
+Reply const error::ERR_NORECIPIENT(std::string const& serverHost, std::string const& nick, std::string const& command) {
+	return (ReplyFormat() << ":" << serverHost << " 411 " << nick << " :No recipient given (" << command << ")" << CRLF).done();
 }
 
-std::string const error::ERR_TOOMANYCHANNELS(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 405 " + nick + " " + chName + " :You have joined too many channels" + suffix;
+Reply const error::ERR_NOTEXTTOSEND(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 412 " << nick << " :No text to send" << CRLF).done();
 }
 
-std::string const error::ERR_CHANNELISFULL(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 471 " + nick + " " + chName + " :Cannot join channel (+l)" + suffix;
+Reply const error::ERR_NOPRIVILEGES(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 481 " << nick << " :Permission Denied- You're not an IRC operator" << CRLF).done();
 }
 
-std::string const error::ERR_INVITEONLYCHAN(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 473 " + nick + " " + chName + " :Cannot join channel (+i)" + suffix;
+Reply const error::ERR_NOOPERHOST(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 491 " << nick << " :No O-lines for your host" << CRLF).done();
 }
 
-std::string const error::ERR_BADCHANNELKEY(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 475 " + nick + " " + chName + " :Cannot join channel (+k)" + suffix;
+Reply const error::ERROR_CLOSINGLINK(std::string const& host, std::string const& reason) {
+	return (ReplyFormat() << "ERROR :Closing Link: " << host << " (" << reason << ")" << CRLF).done();
 }
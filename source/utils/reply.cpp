@@ -1,67 +1,101 @@
 #include "../../include/utils/reply.hpp"
 
-std::string const suffix = "\r\n";
+Reply const reply::RPL_WELCOME(std::string const& server_host, std::string const& nick, std::string const& user, std::string const& host) {
+	return (ReplyFormat() << ":" << server_host << " 001 " << nick << " :Welcome to the Internet Relay Network " << nick << "!" << user << "@" << host << CRLF).done();
+}
+
+Reply const reply::RPL_YOURHOST(std::string const& server_host, std::string const& nick, std::string const& version) {
+	return (ReplyFormat() << ":" << server_host << " 002 " << nick << " :Your host is " << server_host << ", running version " << version << CRLF).done();
+}
+
+Reply const reply::RPL_CREATED(std::string const& server_host, std::string const& nick, std::string const& date) {
+	return (ReplyFormat() << ":" << server_host << " 003 " << nick << " :This server was created " << date << CRLF).done();
+}
+
+Reply const reply::RPL_MYINFO(std::string const& server_host, std::string const& nick, std::string const& version, std::string const& usermode, std::string const& chanmode) {
+	return (ReplyFormat() << ":" << server_host << " 004 " << nick << " :" << server_host << " " << version << " " << usermode << " " << chanmode << CRLF).done();
+}
+
+Reply const reply::RPL_ISUPPORT(std::string const& server_host, std::string const& nick) {
+	return (ReplyFormat() << ":" << server_host << " 005 " << nick << " :CASEMAPPING=rfc1459 CHANMODES=i,t,k,o,l CHANTYPES=&# CHARSET=ascii MASCHANNELS=10 MAXNICKLEN=9" << CRLF).done();
+}
+
+Reply const reply::RPL_MOTDSTART(std::string const& server_host, std::string const& nick) {
+	return (ReplyFormat() << ":" << server_host << " 375 " << nick << " :- " << server_host << " Message of the day - " << CRLF).done();
+}
+
+Reply const reply::RPL_MOTD(std::string const& server_host, std::string const& nick, std::string const& line) {
+	return (ReplyFormat() << ":" << server_host << " 372 " << nick << " :" << line << CRLF).done();
+}
+
+Reply const reply::RPL_ENDOFMOTD(std::string const& server_host, std::string const& nick) {
+	return (ReplyFormat() << ":" << server_host << " 376 " << nick << " :End of /MOTD command." << CRLF).done();
+}
 
-std::string const reply::RPL_WELCOME(std::string const& server_host, std::string const& nick, std::string const& user, std::string const& host) {
-	return ":" + server_host + " 001 " + nick + " :Welcome to the Internet Relay Network " + nick + "!" + user + "@" + host + suffix;
+Reply const reply::RPL_CHANNELMODEIS(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& mode, std::string const& argument) {
+	return (ReplyFormat() << ":" << serverHost << " 324 " << nick << " " << chName << " " << mode << " " << argument << CRLF).done();
 }
 
-std::string const reply::RPL_YOURHOST(std::string const& server_host, std::string const& nick, std::string const& version) {
-	return ":" + server_host + " 002 " + nick + " :Your host is " + server_host + ", running version " + version + suffix;
+Reply const reply::RPL_CREATIONTIME(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& time) {
+	return (ReplyFormat() << ":" << serverHost << " 329 " << nick << " " << chName << " :" << time << CRLF).done();
 }
 
-std::string const reply::RPL_CREATED(std::string const& server_host, std::string const& nick, std::string const& date) {
-	return ":" + server_host + " 003 " + nick + " :This server was created " + date + suffix;
+Reply const reply::RPL_SUCCESSMODE(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName, std::string const& mode, std::string const& argument) {
+	return (ReplyFormat() << ":" << nick << "!" << user << "@" << host << " MODE " << chName << " " << mode << " " << argument << CRLF).done();
 }
 
-std::string const reply::RPL_MYINFO(std::string const& server_host, std::string const& nick, std::string const& version, std::string const& usermode, std::string const& chanmode) {
-	return ":" + server_host + " 004 " + nick + " :" + server_host + " " + version + " " + usermode + " " + chanmode + suffix;
+Reply const reply::RPL_SUCCESSJOIN(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName) {
+	return (ReplyFormat() << ":" << nick << "!" << user << "@" << host << " JOIN " << chName << " :" << chName << CRLF).done();
 }
 
-std::string const reply::RPL_ISUPPORT(std::string const& server_host, std::string const& nick) {
-	return ":" + server_host + " 005 " + nick + " :CASEMAPPING=rfc1459 CHANMODES=i,t,k,o,l CHANTYPES=&# CHARSET=ascii MASCHANNELS=10 MAXNICKLEN=9" + suffix; 
+Reply const reply::RPL_TOPIC(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& topic) {
+	return (ReplyFormat() << ":" << serverHost << " 332 " << nick << " " << chName << " :" << topic << CRLF).done();
 }
 
-std::string const reply::RPL_MOTDSTART(std::string const& server_host, std::string const& nick) {
-	return ":" + server_host + " 375 " + nick + " :- " + server_host + " Message of the day - " + suffix;
+Reply const reply::RPL_NAMREPLY(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& userList) {
+	return (ReplyFormat() << ":" << serverHost << " 353 " << nick << " = " << chName << " :" << userList << CRLF).done();
 }
 
-std::string const reply::RPL_MOTD(std::string const& server_host, std::string const& nick, std::string const& line) {
-	return ":" + server_host + " 372 " + nick + " :" + line + suffix;
+Reply const reply::RPL_ENDOFNAMES(std::string const& serverHost, std::string const& nick, std::string const& chName) {
+	return (ReplyFormat() << ":" << serverHost << " 366 " << nick << " " << chName << " :End of /NAMES list." << CRLF).done();
 }
 
-std::string const reply::RPL_ENDOFMOTD(std::string const& server_host, std::string const& nick) {
-	return ":" + server_host + " 376 " + nick + " :End of /MOTD command." + suffix;
+Reply const reply::RPL_SUCCESSQUIT(std::string const& nick, std::string const& user, std::string const& host, std::string const& reason) {
+	return (ReplyFormat() << ":" << nick << "!" << user << "@" << host << " QUIT :Quit: " << reason << CRLF).done();
 }
 
-std::string const reply::RPL_CHANNELMODEIS(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& mode, std::string const& argument) {
-	return ":" + serverHost + " 324 " + nick + " " + chName + " " + mode + " " + argument + suffix;
+// PRIVMSG, NOTICE 공용. command에 둘 중 하나를 넘긴다
+Reply const reply::RPL_PRIVMSG(std::string const& nick, std::string const& user, std::string const& host, std::string const& command, std::string const& target, std::string const& text) {
+	return (ReplyFormat() << ":" << nick << "!" << user << "@" << host << " " << command << " " << target << " :" << text << CRLF).done();
 }
 
-std::string const reply::RPL_CREATIONTIME(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& time) {
-	return ":" + serverHost + " 329 " + nick + " " + chName + " :" + time;
+Reply const reply::RPL_YOUREOPER(std::string const& serverHost, std::string const& nick) {
+	return (ReplyFormat() << ":" << serverHost << " 381 " << nick << " :You are now an IRC operator" << CRLF).done();
 }
 
-std::string const reply::RPL_SUCCESSMODE(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName, std::string const& mode, std::string const& argument) {
-	return ":" + nick + "!" + user + "@" + host + " MODE " + chName + " " + mode + " " + argument + suffix;
+// STATS m. 원격(서버 간) 호출 수는 늘 0
+Reply const reply::RPL_STATSCOMMANDS(std::string const& serverHost, std::string const& nick, std::string const& command, std::string const& count, std::string const& bytes) {
+	return (ReplyFormat() << ":" << serverHost << " 212 " << nick << " " << command << " " << count << " " << bytes << " 0" << CRLF).done();
 }
 
-std::string const reply::RPL_SUCCESSJOIN(std::string const& nick, std::string const& user, std::string const& host, std::string const& chName) {
-	return ":" + nick + "!" + user + "@" + host + " JOIN " + chName + " :" + chName + suffix;
+Reply const reply::RPL_STATSUPTIME(std::string const& serverHost, std::string const& nick, std::string const& uptime) {
+	return (ReplyFormat() << ":" << serverHost << " 242 " << nick << " :Server Up " << uptime << CRLF).done();
 }
 
-std::string const reply::RPL_TOPIC(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& topic) {
-	return ":" + serverHost + " 332 " + nick + " " + chName + " :" + topic + suffix;
+// STATS의 자유 형식 줄(지연 시간 분포, 카운터)
+Reply const reply::RPL_STATSDEBUG(std::string const& serverHost, std::string const& nick, std::string const& text) {
+	return (ReplyFormat() << ":" << serverHost << " 249 " << nick << " :" << text << CRLF).done();
 }
 
-std::string const reply::RPL_NAMREPLY(std::string const& serverHost, std::string const& nick, std::string const& chName, std::string const& userList) {
-	return ":" + serverHost + " 353 " + nick + " = " + chName + " :" + userList + suffix;
+Reply const reply::RPL_ENDOFSTATS(std::string const& serverHost, std::string const& nick, std::string const& query) {
+	return (ReplyFormat() << ":" << serverHost << " 219 " << nick << " " << query << " :End of STATS report" << CRLF).done();
 }
 
-std::string const reply::RPL_ENDOFNAMES(std::string const& serverHost, std::string const& nick, std::string const& chName) {
-	return ":" + serverHost + " 366 " + nick + " " + chName + " :End of /NAMES list." + suffix;
+// 조용한 클라이언트에게 서버가 먼저 보내는 PING
+Reply const reply::RPL_PING(std::string const& serverHost) {
+	return (ReplyFormat() << "PING :" << serverHost << CRLF).done();
 }
 
-std::string const reply::RPL_SUCCESSQUIT(std::string const& nick, std::string const& user, std::string const& host, std::string const& reason) {
-	return ":" + nick + "!" + user + "@" + host + " QUIT :Quit: " + reason + suffix;
+Reply const reply::RPL_PONG(std::string const& serverHost) {
+	return (ReplyFormat() << ":" << serverHost << " PONG " << serverHost << " :" << serverHost << CRLF).done();
 }
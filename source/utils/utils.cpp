@@ -1,9 +1,24 @@
 #include "../../include/utils/utils.hpp"
+#include <cstring>
+
+static THREAD_LOCAL time_t cachedTime = 0;
 
 time_t getCurTime() {
 	return time(NULL);
 }
 
+time_t updateCachedTime() {
+	cachedTime = time(NULL);
+	return cachedTime;
+}
+
+// 아직 한 번도 읽지 않은 스레드라면 지금 읽는다
+time_t getCachedTime() {
+	if (cachedTime == 0)
+		return updateCachedTime();
+	return cachedTime;
+}
+
 std::string getStringTime(time_t const& time) {
 	char buf[50];
 	struct tm* tm;
@@ -22,3 +37,15 @@ bool chkForbiddenChar(std::string const& str, std::string const& forbidden_set)
 	}
 	return false;
 }
+
+std::string foldNick(std::string const& nick) {
+	std::string folded(nick);
+
+	for (size_t i = 0; i < folded.size(); i++) {
+		char c = folded[i];
+
+		if (c >= 'A' && c <= '^')
+			folded[i] = c + ('a' - 'A');
+	}
+	return folded;
+}